@@ -5,6 +5,19 @@
 // Константи для типів клітинок
 const char WALL = 'x', EMPTY = '_', START = 's', FINISH = 'f', TRAP = 'd', PLAYER = 'P';
 
+// Напрямки руху (порядок відповідає клавішам 'w', 'a', 's', 'd')
+enum Direction {
+    DIR_UP,
+    DIR_LEFT,
+    DIR_DOWN,
+    DIR_RIGHT,
+    DIR_COUNT
+};
+
+const char DIRECTION_KEYS[DIR_COUNT] = { 'w', 'a', 's', 'd' };
+const int DIRECTION_DX[DIR_COUNT] = { 0, -1, 0, 1 };
+const int DIRECTION_DY[DIR_COUNT] = { -1, 0, 1, 0 };
+
 // Стани гри
 enum GameState {
     MENU,
@@ -27,6 +40,33 @@ const int MAX_VISIBLE_LEVELS = 10;
 // Кількість елементів меню
 const int MENU_ITEMS = 4;
 
+// Ім'я файлу пакета рівнів у директорії рівнів
+const char* const LEVEL_PACK_FILE = "levels.pak";
+
+// Ім'я файлу з мініатюрами рівнів у директорії рівнів
+const char* const THUMBNAIL_CACHE_FILE = "thumbnails.cache";
+
+// Максимальний обсяг пам'яті кешу розібраних рівнів (у байтах)
+const size_t LEVEL_CACHE_MEMORY_LIMIT = 4 * 1024 * 1024;
+
+// Максимальний обсяг пам'яті кешу текстур тексту (у байтах)
+const size_t TEXT_CACHE_MEMORY_LIMIT = 8 * 1024 * 1024;
+
+// Скільки сусідніх рівнів з кожного боку завантажувати наперед у списку рівнів
+const int PREFETCH_RADIUS = 3;
+
 // Часові константи для анімацій (у мілісекундах)
 const int ANIMATION_STEP_TIME = 200;
-const int TRAIL_LIFETIME = 200;
\ No newline at end of file
+const int TRAIL_LIFETIME = 200;
+
+// Темп кадрів: цільова частота під час анімацій і найдовше очікування подій у спокої (мс)
+const int TARGET_FPS = 60;
+const int IDLE_WAIT_TIMEOUT = 250;
+
+// Профайлер кадру: як часто оновлюються цифри оверлея (мс) і куди зберігати CSV
+const int PROFILER_OVERLAY_INTERVAL = 250;
+const char* const PROFILER_CSV_FILE = "frame_profile.csv";
+
+// Трасування зон (лише зі збіркою PUSHPUSH_TRACE): останні події кожного потоку і файл для Perfetto
+const int TRACE_BUFFER_EVENTS = 32768;
+const char* const TRACE_FILE = "trace.json";
@@ -5,6 +5,7 @@
 #include <vector>
 #include "renderer.h"
 #include "level.h"
+#include "grid.h"
 
 // Enumeration for selected brush types
 enum BrushType {
@@ -41,7 +42,7 @@ private:
     BrushType currentBrush;
 
     // Level data
-    std::vector<std::vector<char>> levelData;
+    Grid levelData;
     bool hasStart;
     bool hasFinish;
 
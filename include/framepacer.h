@@ -0,0 +1,25 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+// Темп головного циклу: під час анімацій тримає цільову частоту кадрів
+// з урахуванням часу самого кадру, а в спокої спить до наступної події.
+class FramePacer {
+private:
+    Uint64 frameDuration;   // Тривалість кадру в наносекундах
+    Uint64 nextFrameTime;   // Коли має початися наступний кадр
+    bool limitRate;         // Чи потрібно обмежувати частоту самостійно
+    bool wasIdle;
+
+public:
+    explicit FramePacer(int targetFps);
+
+    // Враховує вертикальну синхронізацію: якщо презентація вже чекає на
+    // дисплей з частотою не вищою за цільову, власне обмеження зайве
+    void configure(bool vsyncEnabled, float refreshRate);
+
+    // Чекає перед наступним кадром. Без анімацій чекає на подію, але не
+    // довше за idleTimeout мс, щоб фонові задачі могли відпрацювати.
+    // presented - чи кадр був показаний: лише тоді очікування VSync вже минуло
+    void wait(bool animating, bool presented, int idleTimeout);
+};
@@ -2,10 +2,20 @@
 
 #include "audio.h"
 #include "constants.h"
+#include "framepacer.h"
+#include "generator.h"
 #include "level.h"
+#include "levelcache.h"
+#include "levelindex.h"
+#include "levelpack.h"
+#include "levelsearch.h"
+#include "profiler.h"
+#include "prefetcher.h"
 #include "renderer.h"
+#include "thumbnails.h"
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -13,10 +23,18 @@ class Game {
 private:
     GameState currentState;
     int selectedMenuItem;
-    int selectedLevelIndex;
+    int selectedLevelIndex;       // Позиція у відфільтрованому списку
     int firstVisibleLevel;
     std::vector<std::string> levelFiles;
+    Uint64 levelFilesVersion;     // Версія індексу, з якої зібрано levelFiles
+    LevelSearch levelSearch;
+    std::string searchQuery;
     std::string menuItems[MENU_ITEMS];
+
+    // Відстеження змін: кадр малюється лише якщо щось змінилось
+    bool frameDirty;
+    GameState drawnState;         // Стан, показаний в останньому кадрі
+    Uint64 skippedFrames;
     
     std::string fontPath;
     std::string levelsPath;
@@ -24,7 +42,15 @@ private:
     // Основні компоненти
     Renderer renderer;
     Level* currentLevel;
+    LevelCache levelCache;
+    LevelPack levelPack;
+    LevelIndex levelIndex;
+    LevelPrefetcher prefetcher;
+    LevelThumbnails thumbnails;
     AudioManager audioManager;
+    FramePacer framePacer;
+    FrameProfiler profiler;
+    std::unique_ptr<LevelGenerator> generator; // Поки генерація триває у фоні
 
 public:
     Game();
@@ -33,12 +59,22 @@ public:
     bool initialize();
     void cleanup();
     void run();
+
+    Uint64 getSkippedFrames() const { return skippedFrames; }
     
 private:
     void refreshLevelList();
+    bool rebuildLevelList();
+    const std::vector<int>& getLevelView();
+    int findPackedLevel(const std::string& fileName) const;
+    void selectLevel(int viewIndex);
+    void setSearchQuery(const std::string& query);
     void handleEvents();
     void handleMainMenuInput(SDL_Event& e);
     void handleLevelSelectInput(SDL_Event& e);
     void handleGameInput(SDL_Event& e);
     void loadSelectedLevel();
+    void prefetchNeighbours();
+    void requestThumbnails();
+    void updateGenerator();
 };
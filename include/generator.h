@@ -0,0 +1,74 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+// Параметри генерації рівнів
+struct GeneratorSettings {
+    unsigned int seed;      // Зерно генератора (однакове зерно - однакові рівні)
+    int levelCount;         // Скільки рівнів потрібно згенерувати
+    int minPar;             // Мінімальна кількість ходів оптимального розв'язку
+    int maxPar;             // Максимальна кількість ходів оптимального розв'язку
+    int minSize;            // Мінімальний розмір сторони (не менше LevelCreator::MIN_SIZE)
+    int maxSize;            // Максимальний розмір сторони (не більше LevelCreator::MAX_SIZE)
+    float wallDensity;      // Ймовірність стіни у внутрішній клітинці
+    float trapDensity;      // Ймовірність пастки у внутрішній клітинці
+    int threadCount;        // Кількість потоків (0 - за кількістю ядер)
+    int maxAttempts;        // Ліміт кандидатів на один рівень
+    std::string namePrefix; // Префікс імен файлів
+};
+
+// Статистика роботи генератора
+struct GeneratorStats {
+    int levelsGenerated;
+    long long candidatesTried;
+    double seconds;
+    double levelsPerSecond;
+    double candidatesPerSecond;
+};
+
+class LevelGenerator {
+private:
+    std::string outputPath;
+    GeneratorSettings settings;
+    int threadCount;
+
+    // Лічильники поточного запуску; фоновий запуск читає їх з головного потоку
+    std::thread thread;
+    std::atomic<int> nextLevel;
+    std::atomic<int> generated;
+    std::atomic<long long> candidates;
+    std::atomic<bool> cancelled;
+    std::atomic<bool> finished;
+    std::chrono::steady_clock::time_point startTime;
+    std::chrono::steady_clock::time_point endTime; // Записується до finished
+
+    // Генерує один рівень із заданим номером; повертає false, якщо ліміт спроб вичерпано
+    bool generateLevel(int levelIndex, long long& candidates);
+    void reset();
+    void generate();
+
+public:
+    LevelGenerator(const std::string& outputPath, const GeneratorSettings& settings);
+    ~LevelGenerator();
+
+    LevelGenerator(const LevelGenerator&) = delete;
+    LevelGenerator& operator=(const LevelGenerator&) = delete;
+
+    static GeneratorSettings defaultSettings(unsigned int seed);
+    int getLevelCount() const { return settings.levelCount; }
+
+    // Запускає генерацію на кількох потоках і записує рівні у форматі .bin
+    GeneratorStats run();
+
+    // Те саме у фоні: головний потік лише опитує isFinished() і getStats()
+    void start();
+    bool isFinished() const { return finished.load(std::memory_order_acquire); }
+    // Зупиняє генерацію після поточних кандидатів і чекає на потоки
+    void cancel();
+
+    // Під час роботи - проміжний результат і поточна швидкість
+    GeneratorStats getStats() const;
+};
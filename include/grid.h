@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <span>
+
+// Плоска сітка клітинок рівня: один буфер, рядки розташовані підряд (row-major).
+// Індекс клітинки - y * stride + x; зараз stride завжди дорівнює ширині,
+// тож увесь буфер збігається з тілом .bin файлу і читається/пишеться одним блоком.
+class Grid {
+private:
+    int width;
+    int height;
+    int stride;
+    std::vector<char> cells;
+
+public:
+    Grid() : width(0), height(0), stride(0) {}
+    Grid(int width, int height, char fill) : Grid() { resize(width, height, fill); }
+
+    // Змінює розмір сітки і заповнює її вказаною клітинкою
+    void resize(int newWidth, int newHeight, char fill) {
+        width = newWidth;
+        height = newHeight;
+        stride = newWidth;
+        cells.assign((size_t)stride * height, fill);
+    }
+
+    void clear() {
+        width = height = stride = 0;
+        cells.clear();
+    }
+
+    // Розміри
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    int getStride() const { return stride; }
+    int getCellCount() const { return stride * height; }
+    bool isEmpty() const { return cells.empty(); }
+
+    // Індексація
+    bool inBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+    int index(int x, int y) const { return y * stride + x; }
+    int indexX(int index) const { return index % stride; }
+    int indexY(int index) const { return index / stride; }
+
+    char at(int x, int y) const { return cells[index(x, y)]; }
+    char& at(int x, int y) { return cells[index(x, y)]; }
+    char operator[](int index) const { return cells[index]; }
+    char& operator[](int index) { return cells[index]; }
+
+    // Окремий рядок
+    std::span<char> row(int y) { return { cells.data() + (size_t)y * stride, (size_t)width }; }
+    std::span<const char> row(int y) const { return { cells.data() + (size_t)y * stride, (size_t)width }; }
+
+    // Увесь буфер для масового читання/запису
+    std::span<char> data() { return cells; }
+    std::span<const char> data() const { return cells; }
+};
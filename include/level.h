@@ -1,28 +1,28 @@
 #pragma once
 
 #include "constants.h"
+#include "grid.h"
+#include "movelog.h"
+#include "trail.h"
+#include <span>
 #include <vector>
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <iostream>
 #include <filesystem>
 #include <SDL3/SDL.h>
 
-class Level {
-public:
-    // Структура для зберігання точок сліду гравця
-    struct TrailPoint {
-        int x, y;
-        Uint32 timeCreated;
-    };
+class LevelPack;
 
+class Level {
 private:
     // Дані рівня
-    int width;
-    int height;
-    std::vector<std::vector<char>> levelData;
+    Grid levelData;
     int playerX;
     int playerY;
+    int startX; // Стартова позиція завантаженого рівня
+    int startY;
     std::string levelsPath;
 
     // Змінні для стану гри
@@ -32,9 +32,43 @@ private:
     // Змінні для анімації
     int animationRadius;
     Uint32 lastAnimationTime;
+    Uint64 attemptCount; // Кількість завершених спроб: нова анімація - новий номер
+
+    // Слід гравця
+    Trail trail;
+
+    // Таблиці зупинок: для кожної клітинки і напрямку - індекс клітинки,
+    // де зупиниться гравець (slideTargets[cell * DIR_COUNT + dir])
+    std::vector<int> slideTargets;
+    void buildSlideTables();
+
+    // Клітинки, з яких ще можна дійти до фінішу (зворотний пошук від фінішу),
+    // кількість ходів до фінішу і оптимальний напрямок для кожної клітинки
+    std::vector<bool> finishReachable;
+    std::vector<int> finishDistance;
+    std::vector<signed char> hintDirections;
+    std::vector<int> reverseOffsets;
+    std::vector<int> reverseEdges;
+    void buildReachability();
+
+    // Кільця анімації завершення: цілочисельна відстань кожної клітинки від
+    // гравця і клітинки, згруповані за кільцями (revealCells[revealOffsets[r] .. revealOffsets[r + 1]))
+    std::vector<int> revealRing;
+    std::vector<int> revealOffsets;
+    std::vector<int> revealCells;
+    void buildRevealRings();
+
+    // Журнал ходів для скасування і повтору
+    MoveLog moveLog;
+
+    // Виконання ходу без запису в журнал; повертає true, якщо позиція змінилась
+    bool applyMove(int dir);
+
+    // Скидання стану гри без логування
+    void resetState();
 
-    // Змінні для сліду гравця
-    std::vector<TrailPoint> trail;
+    // Завершення спроби перемогою чи поразкою із запуском анімації
+    void endAttempt(bool finished);
 
 public:
     // Конструктор і деструктор
@@ -42,28 +76,50 @@ public:
     ~Level();
 
     // Властивості рівня
-    int getWidth() const { return width; }
-    int getHeight() const { return height; }
+    int getWidth() const { return levelData.getWidth(); }
+    int getHeight() const { return levelData.getHeight(); }
+    const Grid& getGrid() const { return levelData; }
     int getPlayerX() const { return playerX; }
     int getPlayerY() const { return playerY; }
+    int getStartX() const { return startX; }
+    int getStartY() const { return startY; }
     char getTileAt(int x, int y) const;
+    int getSlideTarget(int x, int y, int direction) const;
+    bool isCellDoomed(int x, int y) const;
+    int getFinishDistance(int x, int y) const;
+    int getHintDirection() const;
 
     // Стан гри
     bool isLevelFinished() const { return isFinished; }
     bool isLevelFailed() const { return isFailed; }
+    // Чи змінюється картинка з часом (слід або розкриття після завершення)
+    bool isAnimating() const;
     void reset();
+    void restart();
 
     // Операції з файлами рівнів
-    std::vector<std::string> getLevelFileList();
-    bool loadLevelFromFile(const std::string& filename);
+    std::string getLevelPath(const std::string& filename) const;
     void createDefaultLevel();
+    void loadLevelData(const Grid& grid, int startX, int startY);
+    bool loadLevelFromPack(const LevelPack& pack, int index);
+    static bool readLevelFile(const std::string& filePath, Grid& grid, int& startX, int& startY);
+    static bool saveLevelToFile(const std::string& filePath, const Grid& grid, int startX, int startY);
 
     // Ігрова логіка
     bool isObstacle(int x, int y) const;
     void movePlayer(char direction);
+    bool undoMove();
+    bool redoMove();
+    const MoveLog& getMoveLog() const { return moveLog; }
 
     // Методи для анімацій
-    void updateAnimations(Uint32 currentTime);
+    // Повертає true, якщо картинка змінилась і кадр треба перемалювати
+    bool updateAnimations(Uint32 currentTime);
     int getAnimationRadius() const;
-    const std::vector<TrailPoint>& getTrail() const { return trail; }
+    Uint64 getAttemptCount() const { return attemptCount; }
+    int getRevealRingCount() const { return revealOffsets.empty() ? 0 : (int)revealOffsets.size() - 1; }
+    std::span<const int> getRevealRing(int ring) const {
+        return std::span<const int>(revealCells).subspan(revealOffsets[ring], revealOffsets[ring + 1] - revealOffsets[ring]);
+    }
+    const Trail& getTrail() const { return trail; }
 };
\ No newline at end of file
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "grid.h"
+#include "level.h"
+#include <SDL3/SDL.h>
+#include <list>
+#include <string>
+#include <unordered_map>
+
+// Обмежений за пам'яттю LRU-кеш розібраних рівнів.
+// Ключ - шлях до файлу; запис дійсний, поки збігаються розмір і час зміни,
+// тож повторне відкриття рівня коштує лише один запит stat.
+class LevelCache {
+public:
+    struct Entry {
+        Grid grid;
+        int startX;
+        int startY;
+        Uint64 fileSize;
+        SDL_Time modifyTime;
+    };
+
+private:
+    typedef std::list<std::pair<std::string, Entry>> EntryList;
+
+    size_t memoryLimit;
+    size_t memoryUsed;
+    EntryList entries; // Найсвіжіші записи на початку списку
+    std::unordered_map<std::string, EntryList::iterator> index;
+
+    Uint64 hits;
+    Uint64 misses;
+    Uint64 evictions;
+
+    static size_t entrySize(const std::string& filePath, const Entry& entry);
+    void evictToLimit();
+
+public:
+    explicit LevelCache(size_t memoryLimit);
+
+    // Завантажує рівень у level: з кешу, якщо файл не змінився, інакше з диска
+    bool load(const std::string& filePath, Level& level);
+
+    // Додає вже розібраний рівень (наприклад, з фонового завантаження)
+    void insert(const std::string& filePath, Entry entry);
+
+    // Отримує розмір і час зміни файлу одним системним викликом
+    static bool statFile(const std::string& filePath, Uint64& fileSize, SDL_Time& modifyTime);
+
+    bool contains(const std::string& filePath) const { return index.find(filePath) != index.end(); }
+    void clear();
+    void setMemoryLimit(size_t limit);
+
+    // Статистика для налаштування розміру кешу
+    size_t getMemoryLimit() const { return memoryLimit; }
+    size_t getMemoryUsed() const { return memoryUsed; }
+    size_t getEntryCount() const { return entries.size(); }
+    Uint64 getHits() const { return hits; }
+    Uint64 getMisses() const { return misses; }
+    Uint64 getEvictions() const { return evictions; }
+};
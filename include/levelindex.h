@@ -0,0 +1,65 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Постійний індекс .bin файлів директорії рівнів у природному порядку.
+// На Linux оновлюється інкрементально за подіями inotify, на інших
+// платформах (або якщо inotify недоступний) - періодичним пересканування
+// у фоновому потоці; головний потік лише підміняє список готовим результатом.
+class LevelIndex {
+private:
+    static const Uint64 RESCAN_INTERVAL = 5000; // мс між пересканування без inotify
+
+    std::string levelsPath;
+    std::vector<std::string> names;
+    Uint64 version;       // Змінюється при кожній зміні списку
+    Uint64 lastScanTime;
+    bool needsRescan;
+    int inotifyFd;
+    int watchFd;
+
+    // Фонове пересканування без inotify; потік запускається при першому запиті
+    std::thread scanner;
+    std::mutex scanMutex;
+    std::condition_variable scanWake;
+    bool scannerRunning;
+    bool scanRequested;
+    bool scanReady;
+    Uint64 scanEpoch;     // Змінюється при синхронному скані - старіші фонові результати відкидаються
+    std::vector<std::string> scannedNames;
+
+    static std::vector<std::string> scanDirectory(const std::string& levelsPath);
+    void applyScan(std::vector<std::string> levelFiles);
+    void rescan();
+    void requestScan();
+    void collectScan();
+    void scannerLoop();
+    bool watchDirectory();
+    void readEvents();
+    void addName(const std::string& name);
+    void removeName(const std::string& name);
+
+public:
+    explicit LevelIndex(const std::string& levelsPath);
+    ~LevelIndex();
+
+    LevelIndex(const LevelIndex&) = delete;
+    LevelIndex& operator=(const LevelIndex&) = delete;
+
+    // Зупиняє фоновий скан (до збереження трасування і в деструкторі)
+    void stop();
+
+    // Дешева перевірка змін: розбирає накопичені події або забирає фоновий скан
+    void update();
+
+    // Примусове синхронне пересканування при наступному update() (наприклад, після збереження рівня)
+    void invalidate() { needsRescan = true; }
+
+    const std::vector<std::string>& getNames() const { return names; }
+    Uint64 getVersion() const { return version; }
+};
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <span>
+#include <string>
+#include <string_view>
+
+// Пакет рівнів в одному файлі, що відображається в пам'ять.
+// Формат: заголовок, відсортований за іменами індекс записів фіксованого
+// розміру і тайли всіх рівнів підряд. Перелік і завантаження рівнів
+// читають дані безпосередньо з відображення, без копіювання файлу.
+class LevelPack {
+public:
+    static const Uint32 PACK_VERSION = 2;
+    static const int MAX_NAME_LENGTH = 47;
+
+    struct Header {
+        char magic[4];       // "PPAK"
+        Uint32 version;
+        Uint32 levelCount;
+        Uint32 indexOffset;
+    };
+
+    struct IndexEntry {
+        char name[MAX_NAME_LENGTH + 1]; // Ім'я файлу рівня, доповнене нулями
+        Uint32 dataOffset;              // Зміщення тайлів від початку файлу
+        Uint16 width;
+        Uint16 height;
+        Sint32 startX;
+        Sint32 startY;
+        Uint64 sourceSize;              // Розмір і час зміни файлу, з якого зібрано запис
+        Sint64 sourceModifyTime;
+    };
+
+private:
+    const char* base;
+    size_t size;
+    const IndexEntry* entries;
+    int levelCount;
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+
+public:
+    LevelPack();
+    ~LevelPack();
+
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    bool open(const std::string& packPath);
+    void close();
+    bool isOpen() const { return base != nullptr; }
+
+    int getLevelCount() const { return levelCount; }
+    const IndexEntry& getEntry(int index) const { return entries[index]; }
+    std::string_view getName(int index) const;
+    std::span<const char> getTiles(int index) const;
+
+    // Пошук рівня за іменем у відсортованому індексі (-1, якщо не знайдено)
+    int find(std::string_view name) const;
+
+    // Як find, але -1 також тоді, коли файл рівня на диску змінився після збирання
+    // пакета (наприклад, перезбережений редактором) - тоді читати слід сам файл.
+    // Рівень без окремого файлу вважається актуальним.
+    int findCurrent(std::string_view name, const std::string& filePath) const;
+
+    // Збирає пакет з усіх .bin файлів директорії
+    static bool build(const std::string& levelsPath, const std::string& packPath);
+};
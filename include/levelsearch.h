@@ -0,0 +1,33 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+// Попередньо побудований індекс для інкрементального пошуку за назвами рівнів.
+// Назви зберігаються в нижньому регістрі в одному буфері, а для кожної є маска
+// символів, що дозволяє відкинути більшість кандидатів без порівняння рядків.
+class LevelSearch {
+private:
+    std::vector<char> text;        // Назви без розширення, одна за одною
+    std::vector<Uint32> offsets;   // Початок кожної назви в text (плюс кінцевий)
+    std::vector<Uint64> charMasks; // Які символи зустрічаються в назві
+
+    std::string lastQuery;
+    std::vector<int> candidates;   // Збіги останнього запиту в порядку списку
+    std::vector<int> results;      // Ті ж збіги, спершу за префіксом
+    std::vector<int> fuzzyMatches; // Робочий буфер для збігів не за префіксом
+
+    static Uint64 charBit(char c);
+    bool matchesPrefix(int index, const std::string& query) const;
+    bool matchesFuzzy(int index, const std::string& query) const;
+
+public:
+    void build(const std::vector<std::string>& names);
+
+    // Повертає індекси назв: спершу ті, що починаються з запиту, потім ті, що
+    // містять його символи по порядку. Уточнення запиту фільтрує попередні збіги.
+    const std::vector<int>& search(const std::string& query);
+
+    int size() const { return (int)charMasks.size(); }
+};
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Компактний журнал ходів для скасування і повтору.
+// Кожен хід - 2-бітний код напрямку (32 ходи в одному 64-бітному слові),
+// а кожні CHECKPOINT_INTERVAL ходів зберігається клітинка гравця перед ходом,
+// тож позицію будь-якого кроку можна відновити не більше ніж за
+// CHECKPOINT_INTERVAL переглядів таблиці зупинок.
+class MoveLog {
+public:
+    static const int CHECKPOINT_INTERVAL = 64;
+
+private:
+    static const int MOVES_PER_WORD = 32;
+
+    std::vector<Uint64> words;
+    std::vector<int> checkpoints;
+    int moveCount; // Записані ходи, включно з тими, що можна повторити
+    int cursor;    // Кількість застосованих ходів
+
+public:
+    MoveLog();
+
+    void clear();
+
+    // Записує хід з клітинки cellBefore і відкидає ходи, доступні для повтору
+    void record(int direction, int cellBefore);
+
+    bool canUndo() const { return cursor > 0; }
+    bool canRedo() const { return cursor < moveCount; }
+    void stepBack() { cursor--; }
+    void stepForward() { cursor++; }
+
+    int getCursor() const { return cursor; }
+    int getMoveCount() const { return moveCount; }
+    int getMove(int index) const;
+
+    // Клітинка гравця перед ходом checkpointStart(index)
+    int getCheckpointCell(int index) const { return checkpoints[index / CHECKPOINT_INTERVAL]; }
+    static int checkpointStart(int index) { return index - index % CHECKPOINT_INTERVAL; }
+
+    size_t getMemoryUsage() const;
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "levelcache.h"
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Фонове завантаження рівнів: робочий потік розбирає файли наперед,
+// а головний потік забирає готові результати в кеш рівнів.
+class LevelPrefetcher {
+private:
+    struct Result {
+        std::string filePath;
+        LevelCache::Entry entry;
+    };
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::string> pending;
+    std::vector<Result> finished;
+    bool running;
+
+    void workerLoop();
+
+public:
+    LevelPrefetcher();
+    ~LevelPrefetcher();
+
+    void start();
+    void stop();
+
+    // Замінює чергу новими шляхами: ще не розпочаті старі запити скасовуються
+    void request(std::vector<std::string> filePaths);
+
+    // Переносить готові рівні в кеш (лише з головного потоку)
+    void collect(LevelCache& cache);
+};
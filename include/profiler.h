@@ -0,0 +1,99 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <string>
+#include <vector>
+
+// Лічильники ресурсів для профайлера кадру. Текстури рахують модулі, які їх
+// створюють і знищують; виділення пам'яті рахує глобальний operator new.
+namespace profiler {
+    void countTextureCreated();
+    void countTextureDestroyed();
+    Uint64 getTexturesCreated();
+    Uint64 getTexturesDestroyed();
+    Uint64 getAllocations(); // Усі потоки, з моменту запуску
+}
+
+// Профайлер головного циклу: час кожної фази кадру в ковзному вікні
+// (гістограми, з яких віднімаються кадри, що випали з вікна) і лічильники за кадр.
+class FrameProfiler {
+public:
+    enum Phase { PHASE_EVENTS, PHASE_ANIMATIONS, PHASE_DRAW, PHASE_PRESENT, PHASE_COUNT };
+
+    struct Frame {
+        Uint64 phaseTime[PHASE_COUNT]; // У наносекундах
+        Uint32 drawCalls;
+        Uint32 texturesCreated;
+        Uint32 texturesDestroyed;
+        Uint32 trailLength;
+        Uint32 allocations;
+        bool presented;                // Незмінені кадри не малюються
+    };
+
+    // Час фази за вікно, у мілісекундах
+    struct PhaseStats {
+        double average;
+        double median;
+        double p95;
+        double max;
+    };
+
+    static constexpr int WINDOW_FRAMES = 240;  // Намальовані кадри у ковзному вікні
+    static constexpr int LOG_FRAMES = 36000;   // Останні кадри для CSV (10 хвилин при 60 FPS)
+    static constexpr int BUCKET_COUNT = 104;   // 16 точних мікросекунд і по 4 кошики на октаву
+    static const char* const PHASE_NAMES[PHASE_COUNT];
+
+private:
+    Frame current;
+    Uint64 phaseStart;
+    Uint64 startDrawCalls;
+    Uint64 startTexturesCreated;
+    Uint64 startTexturesDestroyed;
+    Uint64 startAllocations;
+
+    // Ковзне вікно намальованих кадрів
+    std::vector<std::array<Uint64, PHASE_COUNT>> window;
+    int windowHead;
+    int windowCount;
+    std::array<std::array<Uint32, BUCKET_COUNT>, PHASE_COUNT> histograms;
+    std::array<Uint64, PHASE_COUNT> windowSums;
+
+    // Журнал усіх кадрів для CSV (кільце)
+    std::vector<Frame> log;
+    int logHead;
+    Uint64 frameCount;
+
+    bool overlayVisible;
+    bool overlayUsed;
+    Uint64 lastOverlayTime;
+
+    static int bucketOf(Uint64 nanoseconds);
+    static double bucketMilliseconds(int bucket);
+
+public:
+    FrameProfiler();
+
+    // Початок кадру: запам'ятовує лічильники, щоб рахувати приріст за кадр
+    void beginFrame(Uint64 drawCalls);
+    // Починає відлік наступної фази, не зараховуючи час з попередньої позначки
+    void beginPhase();
+    // Зараховує фазі час з попередньої позначки
+    void endPhase(Phase phase);
+    void endFrame(Uint64 drawCalls, int trailLength, bool presented);
+
+    const Frame& getLastFrame() const;
+    PhaseStats getPhaseStats(Phase phase) const;
+    Uint64 getFrameCount() const { return frameCount; }
+
+    void toggleOverlay();
+    bool isOverlayVisible() const { return overlayVisible; }
+    bool wasOverlayUsed() const { return overlayUsed; }
+
+    // Цифри на екрані оновлюються кілька разів на секунду, а не щокадру,
+    // щоб оверлей не скасовував пропуск незмінених кадрів
+    bool isOverlayDue(Uint64 now) const;
+    void markOverlayDrawn(Uint64 now) { lastOverlayTime = now; }
+
+    bool saveCsv(const std::string& path) const;
+};
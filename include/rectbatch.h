@@ -0,0 +1,38 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <vector>
+
+// Накопичує прямокутники клітинок, згруповані за кольором, і відправляє
+// кожну групу одним викликом SDL_RenderFillRects / SDL_RenderRects.
+// Замість зміни кольору і виклику на кожну клітинку - по виклику на колір.
+class RectBatch {
+private:
+    struct Bucket {
+        Uint32 color;
+        bool outline;
+        std::vector<SDL_FRect> rects;
+    };
+
+    std::vector<Bucket> buckets; // Кольорів небагато, тож лінійний пошук
+    int lastBucket;
+
+    Uint64 drawCalls;
+    Uint64 rectCount;
+
+    static Uint32 packColor(SDL_Color color);
+    std::vector<SDL_FRect>& bucketFor(SDL_Color color, bool outline);
+
+public:
+    RectBatch();
+
+    void addFill(SDL_Color color, const SDL_FRect& rect) { bucketFor(color, false).push_back(rect); }
+    void addOutline(SDL_Color color, const SDL_FRect& rect) { bucketFor(color, true).push_back(rect); }
+
+    // Малює накопичене (спершу заливки, потім контури) з поточним режимом змішування
+    void flush(SDL_Renderer* renderer);
+
+    // Скільки викликів малювання і прямокутників відправлено з моменту створення
+    Uint64 getDrawCalls() const { return drawCalls; }
+    Uint64 getRectCount() const { return rectCount; }
+};
@@ -2,9 +2,15 @@
 
 #include "constants.h"
 #include "level.h"
+#include "profiler.h"
+#include "rectbatch.h"
+#include "textcache.h"
+#include "thumbnails.h"
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 class Renderer {
@@ -17,12 +23,24 @@ private:
     TTF_Font* gameFont;
 
     bool isFullscreen;
+    bool showDoomedOverlay;
+    bool showHint;
 
     // Змінні для масштабування
     float cellSize;
     float offsetX;
     float offsetY;
 
+    // Незмінні клітинки рівня, намальовані один раз у текстуру
+    SDL_Texture* boardTexture;
+    bool boardDirty;
+    int revealedRings; // Скільки кілець анімації завершення вже домальовано в текстуру поля
+    Uint64 revealedAttempt; // Спроба рівня, чиї кільця домальовано
+
+    // Прямокутники клітинок, згруповані за кольором
+    RectBatch cellBatch;
+    Uint64 drawCalls; // Виклики малювання поза пакетами клітинок
+
     // Кольори
     SDL_Color wallColor;
     SDL_Color emptyColor;
@@ -33,13 +51,29 @@ private:
     SDL_Color menuBgColor;
     SDL_Color menuItemColor;
     SDL_Color selectedTextColor;
+    SDL_Color doomedColor;
+
+    TextCache textCache;
+
+    // Рядки, що змінюються щокадру, малюються з атласу гліфів рушія SDL_ttf.
+    // Атлас спільний для всіх шрифтів; на кожен шрифт один об'єкт тексту.
+    TTF_TextEngine* textEngine;
+    std::unordered_map<TTF_Font*, TTF_Text*> dynamicTexts;
 
     SDL_Texture* createTextTexture(const std::string& text, SDL_Color color, TTF_Font* font);
+    SDL_Texture* getTextTexture(const std::string& text, SDL_Color color, TTF_Font* font);
+    TTF_Text* prepareDynamicText(std::string_view text, SDL_Color color, TTF_Font* font);
+    bool buildBoardLayer(const Level& level);
+    void drawBoardLayer();
 
 public:
     // Move this line from private to public section
     void renderText(const std::string& text, int x, int y, SDL_Color color, TTF_Font* font);
 
+    // Для рядків, що змінюються часто (лічильники, введення): без растеризації всього рядка
+    // і без копіювання - можна передати буфер на стеку
+    void renderDynamicText(std::string_view text, int x, int y, SDL_Color color, TTF_Font* font);
+
     Renderer();
     ~Renderer();
 
@@ -49,21 +83,37 @@ public:
     // Функції для відображення
     void calculateScaling(int levelWidth, int levelHeight);
     void toggleFullscreen();
+    void toggleDoomedOverlay();
+    void toggleHint();
+    void handleRenderReset();
+    void invalidateBoard() { boardDirty = true; }
 
     // Відображення різних станів гри
     void drawMainMenu(int selectedMenuItem, const std::string menuItems[]);
-    void drawLevelSelect(const std::vector<std::string>& levelFiles, int selectedLevelIndex, int firstVisibleLevel);
+    void drawLevelSelect(const std::vector<std::string>& levelFiles, const std::vector<int>& levelView,
+        int selectedLevelIndex, int firstVisibleLevel, const std::string& searchQuery, LevelThumbnails& thumbnails);
     void drawLevel(const Level& level);
+    void drawProfilerOverlay(const FrameProfiler& profiler);
+
+    // Показує намальований кадр (окремо від малювання, щоб профайлер міг його виміряти)
+    void present();
 
     // Нові функції для геймплейних механік
-    void drawLevelWin(const Level& level);
-    void drawLevelLose(const Level& level);
-    void drawTrail(const std::vector<Level::TrailPoint>& trail, Uint32 currentTime);
+    void drawLevelEnd(const Level& level);
+    void drawTrail(const Trail& trail, Uint32 currentTime);
 
     // Отримуємо вікно і рендерер
     SDL_Window* getWindow() const { return window; }
     SDL_Renderer* getRenderer() const { return renderer; }
+
+    // Параметри дисплея для темпу кадрів
+    bool isVSyncEnabled() const;
+    float getRefreshRate() const;
+    const TextCache& getTextCache() const { return textCache; }
+    RectBatch& getCellBatch() { return cellBatch; }
+    Uint64 getDrawCalls() const { return drawCalls + cellBatch.getDrawCalls(); }
     float getCellSize() const { return cellSize; }
+    LevelThumbnails::Palette getThumbnailPalette() const { return { wallColor, emptyColor, trapColor, finishColor, startColor }; }
     float getOffsetX() const { return offsetX; }
     float getOffsetY() const { return offsetY; }
     TTF_Font* getSmallFont() const
@@ -0,0 +1,28 @@
+#pragma once
+
+#include "level.h"
+#include <string>
+#include <vector>
+
+// Результат пошуку найкоротшого розв'язку рівня
+struct SolveResult {
+    bool solvable;
+    int par;              // Мінімальна кількість ходів до фінішу (-1, якщо розв'язку немає)
+    int reachableStops;   // Кількість безпечних клітинок зупинки, досяжних зі старту
+    std::string moves;    // Оптимальна послідовність ходів у алфавіті 'w', 'a', 's', 'd'
+};
+
+// Пошук у ширину по графу ковзань рівня.
+// Не використовує SDL і не виділяє пам'ять на кожну вершину:
+// буфери зберігаються між викликами і лише ростуть під більші рівні.
+class LevelSolver {
+private:
+    std::vector<int> distance;   // Кількість ходів до клітинки (-1 - не відвідана)
+    std::vector<int> parent;     // Клітинка, з якої в неї прийшли
+    std::vector<char> parentMove; // Напрямок останнього ходу
+    std::vector<int> queue;      // Черга пошуку фіксованого розміру
+
+public:
+    // Шукає розв'язок з поточної позиції гравця на рівні
+    SolveResult solve(const Level& level);
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+// Обмежений за пам'яттю LRU-кеш текстур з відрендереним текстом.
+// Ключ - рядок, шрифт і колір; кеш володіє текстурами і знищує їх при
+// витісненні, тож при втраті шрифту чи рендерера його треба очистити.
+class TextCache {
+private:
+    struct Key {
+        std::string text;
+        TTF_Font* font;
+        Uint32 color;
+    };
+
+    // Представлення ключа без копіювання рядка - для пошуку
+    struct KeyView {
+        std::string_view text;
+        TTF_Font* font;
+        Uint32 color;
+    };
+
+    struct KeyHash {
+        using is_transparent = void;
+        size_t operator()(const KeyView& key) const;
+        size_t operator()(const Key& key) const { return (*this)(KeyView{ key.text, key.font, key.color }); }
+    };
+
+    struct KeyEqual {
+        using is_transparent = void;
+        static KeyView view(const Key& key) { return { key.text, key.font, key.color }; }
+        static KeyView view(const KeyView& key) { return key; }
+        template <typename A, typename B>
+        bool operator()(const A& a, const B& b) const {
+            KeyView x = view(a), y = view(b);
+            return x.font == y.font && x.color == y.color && x.text == y.text;
+        }
+    };
+
+    struct Entry {
+        Key key;
+        SDL_Texture* texture;
+        size_t size;
+    };
+
+    typedef std::list<Entry> EntryList;
+
+    size_t memoryLimit;
+    size_t memoryUsed;
+    EntryList entries; // Найсвіжіші записи на початку списку
+    std::unordered_map<Key, EntryList::iterator, KeyHash, KeyEqual> index;
+
+    Uint64 hits;
+    Uint64 misses;
+    Uint64 evictions;
+
+    static Uint32 packColor(SDL_Color color);
+    void evictToLimit();
+
+public:
+    explicit TextCache(size_t memoryLimit);
+    ~TextCache();
+
+    TextCache(const TextCache&) = delete;
+    TextCache& operator=(const TextCache&) = delete;
+
+    // Повертає збережену текстуру (кеш залишається її власником) або nullptr
+    SDL_Texture* find(std::string_view text, TTF_Font* font, SDL_Color color);
+
+    // Передає текстуру у власність кешу
+    void insert(std::string_view text, TTF_Font* font, SDL_Color color, SDL_Texture* texture);
+
+    // Знищує всі текстури - перед закриттям шрифтів або при втраті рендерера
+    void clear();
+
+    // Статистика для налаштування розміру кешу
+    size_t getMemoryUsed() const { return memoryUsed; }
+    size_t getEntryCount() const { return entries.size(); }
+    Uint64 getHits() const { return hits; }
+    Uint64 getMisses() const { return misses; }
+    Uint64 getEvictions() const { return evictions; }
+    double getHitRate() const { return hits + misses > 0 ? (double)hits / (hits + misses) : 0.0; }
+};
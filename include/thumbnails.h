@@ -0,0 +1,125 @@
+#pragma once
+
+#include "levelpack.h"
+#include <SDL3/SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Мініатюри рівнів для списку вибору. Робочий потік читає рівні і малює
+// мініатюри в поверхні в пам'яті, головний потік складає їх в атлас і
+// вивантажує на відеокарту невеликими порціями. Мініатюри в атласі ключовані
+// хешем вмісту рівня (однакові рівні під різними іменами ділять слот), а ім'я
+// зв'язане з хешем разом з розміром і часом зміни файлу. Усе це зберігається
+// на диску, тож після перезапуску мініатюри показуються одразу, а незмінений
+// файл перевіряється одним stat, без повторного читання і хешування.
+class LevelThumbnails {
+public:
+    static constexpr int THUMBNAIL_SIZE = 48;
+    static constexpr int ATLAS_COLUMNS = 16;
+    static constexpr int ATLAS_ROWS = 16;
+    static constexpr int UPLOADS_PER_FRAME = 8;
+
+    struct Palette {
+        SDL_Color wall;
+        SDL_Color empty;
+        SDL_Color trap;
+        SDL_Color finish;
+        SDL_Color start;
+    };
+
+    struct Job {
+        std::string name;
+        std::string filePath;        // Порожній для рівнів з пакета
+        int packIndex = -1;          // -1 для окремих файлів
+        // Заповнює request: що відомо про рівень з минулих перевірок
+        Uint64 knownHash = 0;        // Хеш наявної в атласі мініатюри (0 - треба малювати)
+        Uint64 knownSize = 0;
+        SDL_Time knownModifyTime = 0;
+    };
+
+private:
+    struct Result {
+        Job job;
+        Uint64 hash;
+        Uint64 fileSize;
+        SDL_Time modifyTime;
+        SDL_Surface* surface; // nullptr, якщо рівень не змінився
+        bool failed;
+    };
+
+    struct Slot {
+        Uint64 hash;          // 0 - вільний слот
+        Uint64 lastUsed;
+    };
+
+    // Що відомо про рівень з певним іменем
+    struct LevelInfo {
+        Uint64 hash;
+        Uint64 fileSize;      // Для рівнів з пакета - 0
+        SDL_Time modifyTime;
+        bool verified;        // Перевірено в цьому сеансі
+    };
+
+    // Робочий потік
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<Job> pending;
+    std::vector<Result> finished;
+    int inFlight;         // Завдання, які робочий потік саме малює
+    bool running;
+    const LevelPack* pack;
+    Palette palette;
+
+    // Атлас (копія в пам'яті для збереження і відеотекстура)
+    SDL_Surface* atlasSurface;
+    SDL_Texture* atlasTexture;
+    std::vector<Slot> slots;
+    std::unordered_map<Uint64, int> slotByHash;
+    std::unordered_map<std::string, LevelInfo> levels;
+    std::unordered_set<std::string> failedNames;
+    std::vector<int> dirtySlots;
+    Uint64 useCounter;
+    bool modified;
+    std::string cachePath;
+
+    void workerLoop();
+    bool renderJob(const Job& job, Result& result) const;
+    int allocateSlot(Uint64 hash);
+    SDL_Rect slotRect(int slot) const;
+    bool loadCache();
+    void saveCache() const;
+
+public:
+    LevelThumbnails();
+    ~LevelThumbnails();
+
+    LevelThumbnails(const LevelThumbnails&) = delete;
+    LevelThumbnails& operator=(const LevelThumbnails&) = delete;
+
+    void start(const LevelPack* pack, const Palette& palette, const std::string& cachePath);
+    void stop();
+
+    // Замінює чергу: рівні, вже перевірені в цьому сеансі, пропускаються
+    void request(std::vector<Job> jobs);
+
+    // Забирає готові мініатюри і вивантажує частину змінених слотів (лише з головного потоку).
+    // Повертає true, якщо вміст атласу на відеокарті змінився
+    bool upload(SDL_Renderer* renderer);
+
+    // Чи лишилась робота, заради якої варто малювати наступний кадр
+    bool isBusy();
+
+    // Знаходить мініатюру в атласі; повертає false, якщо її ще немає
+    bool find(const std::string& name, SDL_FRect& sourceRect);
+    SDL_Texture* getAtlas() const { return atlasTexture; }
+
+    // Звільняє відеотекстуру (наприклад, перед знищенням рендерера)
+    void releaseTexture();
+};
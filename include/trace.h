@@ -0,0 +1,48 @@
+#pragma once
+
+// Трасування зон часу у форматі Chrome trace (about:tracing, Perfetto).
+// Вмикається опцією CMake PUSHPUSH_TRACE; без неї макроси нічого не генерують.
+//   TRACE_ZONE("Level::movePlayer");  - зона до кінця поточного блоку
+//   TRACE_THREAD_NAME("prefetcher");  - підпис потоку в переглядачі
+//   TRACE_SAVE(path);                 - записує зібрані зони у файл
+
+#ifdef PUSHPUSH_TRACE
+
+#include <SDL3/SDL.h>
+#include <string>
+
+namespace tracing {
+    // Назва зони має жити до збереження - передаємо лише рядкові літерали
+    void record(const char* name, Uint64 start, Uint64 end);
+    void setThreadName(const char* name);
+
+    // Викликати, коли робочі потоки вже зупинено
+    bool save(const std::string& path);
+
+    class Zone {
+    private:
+        const char* name;
+        Uint64 start;
+
+    public:
+        explicit Zone(const char* name) : name(name), start(SDL_GetTicksNS()) {}
+        ~Zone() { record(name, start, SDL_GetTicksNS()); }
+
+        Zone(const Zone&) = delete;
+        Zone& operator=(const Zone&) = delete;
+    };
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+#define TRACE_ZONE(name) tracing::Zone TRACE_CONCAT(traceZone, __LINE__)(name)
+#define TRACE_THREAD_NAME(name) tracing::setThreadName(name)
+#define TRACE_SAVE(path) tracing::save(path)
+
+#else
+
+#define TRACE_ZONE(name) ((void)0)
+#define TRACE_THREAD_NAME(name) ((void)0)
+#define TRACE_SAVE(path) ((void)0)
+
+#endif
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+#include <array>
+#include <vector>
+
+// Слід гравця: кільцевий буфер сегментів фіксованої місткості (один сегмент -
+// одне ковзання) і шар "останнього відвідування" для кожної клітинки.
+// Додавання і старіння сегментів не виділяють пам'ять; шар часу дозволяє
+// відповісти, чи клітинка в сліді, без перебору сегментів.
+class Trail {
+public:
+    static const int CAPACITY = 32; // Більше ходів за TRAIL_LIFETIME не встигнути
+
+    struct Segment {
+        int fromX, fromY; // Перша клітинка сліду (сусідня до старту руху)
+        int toX, toY;     // Остання клітинка сліду (місце зупинки)
+        Uint32 timeCreated;
+    };
+
+private:
+    std::array<Segment, CAPACITY> segments;
+    int head;  // Найстаріший живий сегмент
+    int count;
+
+    int width;
+    std::vector<Uint32> visitTimes; // 0 - клітинку ще не проходили
+
+public:
+    Trail() : segments(), head(0), count(0), width(0) {}
+
+    // Очищує слід під сітку заданого розміру (пам'ять перевикористовується)
+    void reset(int newWidth, int newHeight) {
+        head = count = 0;
+        width = newWidth;
+        visitTimes.assign((size_t)newWidth * newHeight, 0);
+    }
+
+    // Додає сегмент і позначає час на всіх його клітинках;
+    // якщо буфер заповнений, найстаріший сегмент перезаписується
+    void add(const Segment& segment) {
+        if (count == CAPACITY) {
+            head = (head + 1) % CAPACITY;
+            count--;
+        }
+        segments[(head + count) % CAPACITY] = segment;
+        count++;
+
+        int stepX = (segment.toX > segment.fromX) - (segment.toX < segment.fromX);
+        int stepY = (segment.toY > segment.fromY) - (segment.toY < segment.fromY);
+        for (int x = segment.fromX, y = segment.fromY;; x += stepX, y += stepY) {
+            visitTimes[(size_t)y * width + x] = segment.timeCreated;
+            if (x == segment.toX && y == segment.toY) break;
+        }
+    }
+
+    // Прибирає сегменти, старші за lifetime; сегменти впорядковані за часом,
+    // тож перевіряються лише ті, що справді зникають
+    void expire(Uint32 currentTime, Uint32 lifetime) {
+        while (count > 0 && currentTime - segments[head].timeCreated > lifetime) {
+            head = (head + 1) % CAPACITY;
+            count--;
+        }
+    }
+
+    int size() const { return count; }
+    bool empty() const { return count == 0; }
+
+    // Сегмент за віком: 0 - найстаріший живий
+    const Segment& operator[](int index) const { return segments[(head + index) % CAPACITY]; }
+
+    // Коли гравець востаннє проходив клітинку (0 - ніколи з моменту reset)
+    Uint32 getVisitTime(int x, int y) const { return visitTimes[(size_t)y * width + x]; }
+};
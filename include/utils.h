@@ -11,4 +11,7 @@ namespace utils {
 
     // Функція для створення директорій, якщо вони не існують
     bool ensureDirectoryExists(const std::string& path);
+
+    // Природне порівняння імен: числа порівнюються за значенням ("level2" < "level10")
+    bool naturalLess(const std::string& a, const std::string& b);
 }
\ No newline at end of file
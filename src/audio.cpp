@@ -1,4 +1,5 @@
 #include "audio.h"
+#include "trace.h"
 #include <iostream>
 
 AudioManager::AudioManager() : initialized(false), deviceID(0) {
@@ -112,6 +113,7 @@ bool AudioManager::loadSound(const std::string& name, const std::string& filePat
 }
 
 void AudioManager::playSound(const std::string& name) {
+    TRACE_ZONE("AudioManager::playSound");
     if (!initialized) {
         std::cerr << "Audio system not initialized" << std::endl;
         return;
@@ -1,5 +1,7 @@
 #include "creator.h"
 #include "constants.h"
+#include "framepacer.h"
+#include "trace.h"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
@@ -43,6 +45,12 @@ bool LevelCreator::initialize() {
 void LevelCreator::run() {
     bool running = true;
     bool saved = false;
+    FramePacer framePacer(TARGET_FPS);
+    framePacer.configure(renderer.isVSyncEnabled(), renderer.getRefreshRate());
+
+    // Redraw only when input arrived or the text cursor blinked
+    bool frameDirty = true;
+    bool cursorShown = false;
 
     std::cout << "Level Creator started" << std::endl;
 
@@ -50,6 +58,12 @@ void LevelCreator::run() {
         // Handle SDL events
         SDL_Event event;
         while (SDL_PollEvent(&event)) {
+            TRACE_ZONE("LevelCreator::handleEvent");
+
+            if (event.type != SDL_EVENT_MOUSE_MOTION) {
+                frameDirty = true;
+            }
+
             if (event.type == SDL_EVENT_QUIT) {
                 running = false;
                 break;
@@ -76,11 +90,11 @@ void LevelCreator::run() {
                     case SDLK_RETURN:
                         if (parseDimensions()) {
                             // Initialize the level data with the parsed dimensions
-                            levelData.resize(mapHeight, std::vector<char>(mapWidth, EMPTY));
+                            levelData.resize(mapWidth, mapHeight, EMPTY);
                             for (int y = 0; y < mapHeight; y++)
                                 for (int x = 0; x < mapWidth; x++)
                                     if (x == 0 || y == 0 || x == mapWidth - 1 || y == mapHeight - 1)
-                                        levelData[y][x] = WALL;
+                                        levelData.at(x, y) = WALL;
                             cursorX = mapWidth / 2;
                             cursorY = mapHeight / 2;
                             renderer.calculateScaling(mapWidth, mapHeight);
@@ -116,17 +130,30 @@ void LevelCreator::run() {
             }
         }
 
+        bool cursorVisible = currentState == DIMENSIONS_INPUT && inputActive && SDL_GetTicks() % 1000 < 500;
+        if (cursorVisible != cursorShown) {
+            frameDirty = true;
+        }
 
         // Render based on current state
-        if (currentState == DIMENSIONS_INPUT) {
-            renderDimensionsInput();
-        }
-        else if (currentState == LEVEL_EDITING) {
-            renderCreationScreen();
+        if (frameDirty) {
+            if (currentState == DIMENSIONS_INPUT) {
+                renderDimensionsInput();
+            }
+            else if (currentState == LEVEL_EDITING) {
+                renderCreationScreen();
+            }
+            frameDirty = false;
+            cursorShown = cursorVisible;
         }
 
-        // Small delay to avoid hogging CPU
-        SDL_Delay(16);
+        // Nothing moves on these screens: sleep until input arrives,
+        // waking up in time for the next blink of the text cursor
+        int timeout = IDLE_WAIT_TIMEOUT;
+        if (currentState == DIMENSIONS_INPUT && inputActive) {
+            timeout = std::min(timeout, 500 - (int)(SDL_GetTicks() % 500));
+        }
+        framePacer.wait(false, false, timeout);
     }
 
     // Disable text input when done
@@ -137,6 +164,7 @@ void LevelCreator::run() {
 }
 
 void LevelCreator::renderDimensionsInput() {
+    TRACE_ZONE("LevelCreator::renderDimensionsInput");
     // Set background color
     SDL_SetRenderDrawColor(renderer.getRenderer(), 50, 50, 50, 255);
     SDL_RenderClear(renderer.getRenderer());
@@ -171,7 +199,7 @@ void LevelCreator::renderDimensionsInput() {
     if (SDL_GetTicks() % 1000 < 500 && inputActive) {
         displayText += "|"; // Blinking cursor
     }
-    renderer.renderText(displayText.empty() ? " " : displayText, windowWidth / 2 - 90, 230, titleColor, renderer.getSmallFont());
+    renderer.renderDynamicText(displayText.empty() ? " " : displayText, windowWidth / 2 - 90, 230, titleColor, renderer.getSmallFont());
 
 
     // Draw validation constraints
@@ -199,13 +227,13 @@ void LevelCreator::handleTextInput(SDL_Event& e) {
         case SDLK_RETURN:
             if (parseDimensions()) {
                 // Initialize the level data with the parsed dimensions
-                levelData.resize(mapHeight, std::vector<char>(mapWidth, EMPTY));
+                levelData.resize(mapWidth, mapHeight, EMPTY);
 
                 // Add walls around the perimeter
                 for (int y = 0; y < mapHeight; y++) {
                     for (int x = 0; x < mapWidth; x++) {
                         if (x == 0 || y == 0 || x == mapWidth - 1 || y == mapHeight - 1) {
-                            levelData[y][x] = WALL;
+                            levelData.at(x, y) = WALL;
                         }
                     }
                 }
@@ -265,6 +293,7 @@ bool LevelCreator::validateDimensions(int width, int height) {
 }
 
 void LevelCreator::renderCreationScreen() {
+    TRACE_ZONE("LevelCreator::renderCreationScreen");
     // Set background color
     SDL_SetRenderDrawColor(renderer.getRenderer(), 50, 50, 50, 255);
     SDL_RenderClear(renderer.getRenderer());
@@ -277,7 +306,8 @@ void LevelCreator::renderCreationScreen() {
     float offsetX = renderer.getOffsetX();
     float offsetY = renderer.getOffsetY();
 
-    // Draw the level grid
+    // Draw the level grid, batched by color: fills first, then the grid lines on top
+    RectBatch& batch = renderer.getCellBatch();
     for (int y = 0; y < mapHeight; y++) {
         for (int x = 0; x < mapWidth; x++) {
             SDL_FRect cellRect = {
@@ -288,31 +318,32 @@ void LevelCreator::renderCreationScreen() {
             };
 
             // Draw cell based on its type
-            switch (levelData[y][x]) {
+            SDL_Color cellColor;
+            switch (levelData.at(x, y)) {
             case WALL:
-                SDL_SetRenderDrawColor(renderer.getRenderer(), 150, 150, 150, 255);
+                cellColor = { 150, 150, 150, 255 };
                 break;
             case TRAP:
-                SDL_SetRenderDrawColor(renderer.getRenderer(), 196, 36, 44, 255);
+                cellColor = { 196, 36, 44, 255 };
                 break;
             case START:
-                SDL_SetRenderDrawColor(renderer.getRenderer(), 252, 252, 177, 255);
+                cellColor = { 252, 252, 177, 255 };
                 break;
             case FINISH:
-                SDL_SetRenderDrawColor(renderer.getRenderer(), 42, 166, 220, 255);
+                cellColor = { 42, 166, 220, 255 };
                 break;
             default:
-                SDL_SetRenderDrawColor(renderer.getRenderer(), 244, 244, 240, 255);
+                cellColor = { 244, 244, 240, 255 };
                 break;
             }
 
-            SDL_RenderFillRect(renderer.getRenderer(), &cellRect);
+            batch.addFill(cellColor, cellRect);
 
             // Draw grid lines
-            SDL_SetRenderDrawColor(renderer.getRenderer(), 30, 30, 30, 255);
-            SDL_RenderRect(renderer.getRenderer(), &cellRect);
+            batch.addOutline({ 30, 30, 30, 255 }, cellRect);
         }
     }
+    batch.flush(renderer.getRenderer());
 
     // Draw the cursor
     SDL_FRect cursorRect = {
@@ -447,8 +478,8 @@ void LevelCreator::paintCell(int x, int y) {
         if (hasStart) {
             for (int cy = 0; cy < mapHeight; cy++) {
                 for (int cx = 0; cx < mapWidth; cx++) {
-                    if (levelData[cy][cx] == START) {
-                        levelData[cy][cx] = EMPTY;
+                    if (levelData.at(cx, cy) == START) {
+                        levelData.at(cx, cy) = EMPTY;
                     }
                 }
             }
@@ -462,8 +493,8 @@ void LevelCreator::paintCell(int x, int y) {
         if (hasFinish) {
             for (int cy = 0; cy < mapHeight; cy++) {
                 for (int cx = 0; cx < mapWidth; cx++) {
-                    if (levelData[cy][cx] == FINISH) {
-                        levelData[cy][cx] = EMPTY;
+                    if (levelData.at(cx, cy) == FINISH) {
+                        levelData.at(cx, cy) = EMPTY;
                     }
                 }
             }
@@ -474,13 +505,13 @@ void LevelCreator::paintCell(int x, int y) {
 
     case BRUSH_EMPTY:
         // Check if we're removing a special tile
-        if (levelData[y][x] == START) hasStart = false;
-        if (levelData[y][x] == FINISH) hasFinish = false;
+        if (levelData.at(x, y) == START) hasStart = false;
+        if (levelData.at(x, y) == FINISH) hasFinish = false;
         newTile = EMPTY;
         break;
     }
 
-    levelData[y][x] = newTile;
+    levelData.at(x, y) = newTile;
 }
 
 void LevelCreator::switchBrush(BrushType brush) {
@@ -518,7 +549,7 @@ bool LevelCreator::saveLevel(const std::string& fileName) {
     int playerX = -1, playerY = -1;
     for (int y = 0; y < mapHeight; y++) {
         for (int x = 0; x < mapWidth; x++) {
-            if (levelData[y][x] == START) {
+            if (levelData.at(x, y) == START) {
                 playerX = x;
                 playerY = y;
                 break;
@@ -530,29 +561,11 @@ bool LevelCreator::saveLevel(const std::string& fileName) {
     // Create full path to file
     std::string filePath = savePath + "/" + fileName + ".bin";
 
-    // Open file for binary writing
-    std::ofstream outFile(filePath, std::ios::binary | std::ios::out);
-
-    if (!outFile) {
-        std::cerr << "Failed to open file for writing: " << filePath << std::endl;
+    // Write the level in the shared .bin format
+    if (!Level::saveLevelToFile(filePath, levelData, playerX, playerY)) {
         return false;
     }
 
-    // Write level dimensions
-    outFile.write(reinterpret_cast<const char*>(&mapWidth), sizeof(mapWidth));
-    outFile.write(reinterpret_cast<const char*>(&mapHeight), sizeof(mapHeight));
-
-    // Write level data
-    for (int i = 0; i < mapHeight; i++) {
-        outFile.write(levelData[i].data(), mapWidth);
-    }
-
-    // Write player position
-    outFile.write(reinterpret_cast<const char*>(&playerX), sizeof(playerX));
-    outFile.write(reinterpret_cast<const char*>(&playerY), sizeof(playerY));
-
-    outFile.close();
-
     std::cout << "Level successfully saved to " << filePath << std::endl;
     return true;
 }
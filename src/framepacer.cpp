@@ -0,0 +1,43 @@
+#include "framepacer.h"
+
+FramePacer::FramePacer(int targetFps) :
+    frameDuration(SDL_NS_PER_SECOND / targetFps), nextFrameTime(0),
+    limitRate(true), wasIdle(true) {
+}
+
+void FramePacer::configure(bool vsyncEnabled, float refreshRate) {
+    // Невідома частота дисплея (0) - покладаємось на власне обмеження
+    Uint64 targetFps = SDL_NS_PER_SECOND / frameDuration;
+    limitRate = !vsyncEnabled || refreshRate <= 0.0f || refreshRate > targetFps * 1.05f;
+}
+
+void FramePacer::wait(bool animating, bool presented, int idleTimeout) {
+    if (!animating) {
+        // Подія лишається в черзі - її забере звичайна обробка подій
+        SDL_WaitEventTimeout(nullptr, idleTimeout);
+        wasIdle = true;
+        return;
+    }
+
+    Uint64 now = SDL_GetTicksNS();
+    if (wasIdle) {
+        // Після сну відлік кадрів починається заново
+        nextFrameTime = now;
+        wasIdle = false;
+    }
+
+    // Пропущений кадр не чекав на VSync - без обмеження цикл крутився б вхолосту
+    if (!limitRate && presented) {
+        nextFrameTime = now;
+        return;
+    }
+
+    nextFrameTime += frameDuration;
+    if (now < nextFrameTime) {
+        SDL_DelayNS(nextFrameTime - now);
+    }
+    else if (now - nextFrameTime > frameDuration) {
+        // Відстали більше ніж на кадр - не надолужуємо пропущені кадри
+        nextFrameTime = now;
+    }
+}
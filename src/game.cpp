@@ -1,5 +1,10 @@
 #include "game.h"
 #include "creator.h"
+#include "generator.h"
+#include "utils.h"
+#include "trace.h"
+#include <random>
+#include <algorithm>
 #include <iostream>
 
 using namespace std;
@@ -9,17 +14,22 @@ Game::Game() :
     selectedMenuItem(0), 
     selectedLevelIndex(0),
     firstVisibleLevel(0),
-    currentLevel(nullptr) {
+    levelFilesVersion((Uint64)-1),
+    frameDirty(true),
+    drawnState(MENU),
+    skippedFrames(0),
+    fontPath("C:\\Users\\Maxim\\Desktop\\iasa\\icn bin ein programist\\KURSACH\\pushpush\\assetst\\DroidSans-Bold.ttf"),
+    levelsPath("C:\\Users\\Maxim\\Desktop\\iasa\\icn bin ein programist\\KURSACH\\pushpush\\assetst\\levels"),
+    currentLevel(nullptr),
+    levelCache(LEVEL_CACHE_MEMORY_LIMIT),
+    levelIndex(levelsPath),
+    framePacer(TARGET_FPS) {
     
     // Ініціалізуємо пункти меню
     menuItems[0] = "Select Level";
     menuItems[1] = "Create Level";
-    menuItems[2] = "Generate Level (Not Avaliabble)";
+    menuItems[2] = "Generate Level";
     menuItems[3] = "Settings (Not Avaliabble)";
-    
-    // Встановлюємо шляхи
-    fontPath = "C:\\Users\\Maxim\\Desktop\\iasa\\icn bin ein programist\\KURSACH\\pushpush\\assetst\\DroidSans-Bold.ttf";
-    levelsPath = "C:\\Users\\Maxim\\Desktop\\iasa\\icn bin ein programist\\KURSACH\\pushpush\\assetst\\levels";
 }
 
 Game::~Game() {
@@ -46,6 +56,9 @@ bool Game::initialize() {
         SDL_Quit();
         return false;
     }
+
+    // Темп кадрів залежить від VSync і частоти дисплея, відомих лише після створення вікна
+    framePacer.configure(renderer.isVSyncEnabled(), renderer.getRefreshRate());
     
     // Створюємо об'єкт рівня
     currentLevel = new Level(levelsPath);
@@ -70,9 +83,16 @@ bool Game::initialize() {
         audioManager.loadSound("chose", "C:\\Users\\Maxim\\Desktop\\iasa\\icn bin ein programist\\KURSACH\\pushpush\\assetst\\sounds\\chose.wav");
 
     }
+    // Відкриваємо пакет рівнів, якщо він є
+    levelPack.open(levelsPath + "\\" + LEVEL_PACK_FILE);
+
     // Завантажуємо список рівнів
     refreshLevelList();
     
+    // Запускаємо фонове завантаження рівнів і малювання мініатюр
+    prefetcher.start();
+    thumbnails.start(&levelPack, renderer.getThumbnailPalette(), levelsPath + "\\" + THUMBNAIL_CACHE_FILE);
+
     // Якщо немає рівнів, створюємо рівень за замовчуванням
     if (levelFiles.empty()) {
         currentLevel->createDefaultLevel();
@@ -85,7 +105,36 @@ bool Game::initialize() {
 }
 
 void Game::cleanup() {
+    generator.reset(); // Зупиняє незавершену генерацію
+    prefetcher.stop();
+    levelIndex.stop();
+    thumbnails.stop(); // Зберігає атлас і звільняє текстуру до знищення рендерера
+
     if (currentLevel) {
+        cout << "Level cache: " << levelCache.getHits() << " hits, " << levelCache.getMisses() << " misses, "
+            << levelCache.getEvictions() << " evictions, " << levelCache.getMemoryUsed() << " bytes used" << endl;
+
+        const TextCache& textCache = renderer.getTextCache();
+        cout << "Text cache: " << textCache.getHits() << " hits, " << textCache.getMisses() << " misses ("
+            << (int)(textCache.getHitRate() * 100) << "% hit rate), " << textCache.getEvictions() << " evictions, "
+            << textCache.getMemoryUsed() << " bytes used" << endl;
+
+        // Без пакетування кожен прямокутник був би окремим викликом
+        RectBatch& cellBatch = renderer.getCellBatch();
+        cout << "Cell batches: " << cellBatch.getDrawCalls() << " draw calls for "
+            << cellBatch.getRectCount() << " cells" << endl;
+        cout << "Frames skipped without changes: " << skippedFrames << endl;
+
+        // Профіль зберігаємо, лише якщо його переглядали в цьому сеансі
+        const char* basePath = SDL_GetBasePath();
+        std::string outputPath = basePath ? basePath : "";
+        if (profiler.wasOverlayUsed()) {
+            profiler.saveCsv(outputPath + PROFILER_CSV_FILE);
+        }
+
+        // Робочі потоки вже зупинено - їхні буфери зон більше не змінюються
+        TRACE_SAVE(outputPath + TRACE_FILE);
+
         delete currentLevel;
         currentLevel = nullptr;
     }
@@ -96,20 +145,159 @@ void Game::cleanup() {
 }
 
 void Game::refreshLevelList() {
-    levelFiles = currentLevel->getLevelFileList();
-    selectedLevelIndex = 0;
+    // Індекс оновлюється інкрементально, тож повторний вхід у меню нічого не сканує
+    levelIndex.update();
+    rebuildLevelList();
+
+    searchQuery.clear();
     firstVisibleLevel = 0;
+    selectLevel(0);
+}
+
+bool Game::rebuildLevelList() {
+    if (levelIndex.getVersion() == levelFilesVersion) {
+        return false;
+    }
+    levelFilesVersion = levelIndex.getVersion();
+    levelFiles.clear();
+
+    // Спочатку рівні з пакета, потім окремі файли, яких у пакеті немає
+    for (int i = 0; i < levelPack.getLevelCount(); i++) {
+        levelFiles.emplace_back(levelPack.getName(i));
+    }
+    std::sort(levelFiles.begin(), levelFiles.end(), utils::naturalLess);
+
+    for (const auto& fileName : levelIndex.getNames()) {
+        if (levelPack.find(fileName) < 0) {
+            levelFiles.push_back(fileName);
+        }
+    }
+
+    levelSearch.build(levelFiles);
+    return true;
+}
+
+const std::vector<int>& Game::getLevelView() {
+    // Повторний запит з тим самим рядком повертає збережений результат
+    return levelSearch.search(searchQuery);
+}
+
+void Game::selectLevel(int viewIndex) {
+    int count = (int)getLevelView().size();
+    selectedLevelIndex = max(0, min(viewIndex, count - 1));
+
+    // Прокручуємо список так, щоб вибраний рівень був видимим
+    if (selectedLevelIndex < firstVisibleLevel) {
+        firstVisibleLevel = selectedLevelIndex;
+    }
+    else if (selectedLevelIndex >= firstVisibleLevel + MAX_VISIBLE_LEVELS) {
+        firstVisibleLevel = selectedLevelIndex - MAX_VISIBLE_LEVELS + 1;
+    }
+    firstVisibleLevel = max(0, min(firstVisibleLevel, count - MAX_VISIBLE_LEVELS));
+
+    requestThumbnails();
+}
+
+int Game::findPackedLevel(const std::string& fileName) const {
+    // Копія в пакеті не використовується, якщо файл рівня змінився після збирання
+    return levelPack.findCurrent(fileName, currentLevel->getLevelPath(fileName));
+}
+
+void Game::requestThumbnails() {
+    // Мініатюри потрібні лише для видимих рядків
+    const std::vector<int>& levelView = getLevelView();
+    int lastVisible = min((int)levelView.size(), firstVisibleLevel + MAX_VISIBLE_LEVELS);
+
+    std::vector<LevelThumbnails::Job> jobs;
+    for (int i = firstVisibleLevel; i < lastVisible; i++) {
+        const std::string& fileName = levelFiles[levelView[i]];
+        int packIndex = findPackedLevel(fileName);
+        jobs.push_back({ fileName, packIndex < 0 ? currentLevel->getLevelPath(fileName) : std::string(), packIndex });
+    }
+
+    thumbnails.request(std::move(jobs));
+}
+
+void Game::setSearchQuery(const std::string& query) {
+    searchQuery = query;
+    firstVisibleLevel = 0;
+    selectLevel(0);
+    prefetchNeighbours();
+}
+
+void Game::prefetchNeighbours() {
+    const std::vector<int>& levelView = getLevelView();
+    if (levelView.empty()) return;
+
+    // Вибраний рівень першим, далі сусіди в порядку віддалення
+    std::vector<std::string> filePaths;
+    int count = (int)levelView.size();
+    for (int distance = 0; distance <= PREFETCH_RADIUS; distance++) {
+        for (int sign : { 1, -1 }) {
+            const std::string& fileName = levelFiles[levelView[((selectedLevelIndex + sign * distance) % count + count) % count]];
+            std::string filePath = currentLevel->getLevelPath(fileName);
+
+            // Рівні з пакета, вже кешовані і вже додані (у короткому списку сусіди повторюються) пропускаємо
+            if (findPackedLevel(fileName) >= 0 || levelCache.contains(filePath) ||
+                std::find(filePaths.begin(), filePaths.end(), filePath) != filePaths.end()) {
+                continue;
+            }
+            filePaths.push_back(std::move(filePath));
+        }
+    }
+
+    prefetcher.request(std::move(filePaths));
 }
 
 void Game::loadSelectedLevel() {
-    if (!levelFiles.empty()) {
-        if (currentLevel->loadLevelFromFile(levelFiles[selectedLevelIndex])) {
+    // Забираємо рівні, які встиг розібрати фоновий потік
+    prefetcher.collect(levelCache);
+
+    const std::vector<int>& levelView = getLevelView();
+    if (!levelView.empty()) {
+        // Рівні з пакета читаємо з відображення, решту - з кешу, якщо файл не змінився
+        const std::string& fileName = levelFiles[levelView[selectedLevelIndex]];
+        int packIndex = findPackedLevel(fileName);
+        bool loaded = packIndex >= 0 ? currentLevel->loadLevelFromPack(levelPack, packIndex)
+            : levelCache.load(currentLevel->getLevelPath(fileName), *currentLevel);
+        if (loaded) {
             currentState = GAME_PLAYING;
+            SDL_StopTextInput(renderer.getWindow());
             renderer.calculateScaling(currentLevel->getWidth(), currentLevel->getHeight());
         }
     }
 }
 
+void Game::updateGenerator() {
+    if (!generator) return;
+
+    if (!generator->isFinished()) {
+        // Прогрес і швидкість у пункті меню; цикл прокидається щонайменше раз на IDLE_WAIT_TIMEOUT
+        GeneratorStats stats = generator->getStats();
+        char label[64];
+        SDL_snprintf(label, sizeof(label), "Generating %d/%d (%.0f/s)",
+            stats.levelsGenerated, generator->getLevelCount(), stats.candidatesPerSecond);
+        if (menuItems[2] != label) {
+            menuItems[2] = label;
+            frameDirty = true;
+        }
+        return;
+    }
+
+    generator.reset();
+    menuItems[2] = "Generate Level";
+    levelIndex.invalidate();
+    frameDirty = true;
+
+    // Якщо користувач досі в меню - переходимо до вибору нових рівнів
+    if (currentState == MENU) {
+        currentState = LEVEL_SELECT;
+        SDL_StartTextInput(renderer.getWindow());
+        refreshLevelList();
+        prefetchNeighbours();
+    }
+}
+
 // Робота з головним меню
 void Game::handleMainMenuInput(SDL_Event& e) {
     if (e.type == SDL_EVENT_KEY_DOWN) {
@@ -127,7 +315,9 @@ void Game::handleMainMenuInput(SDL_Event& e) {
             // Обробка вибору пункту меню
             if (selectedMenuItem == 0) { // Вибрати рівень
                 currentState = LEVEL_SELECT;
+                SDL_StartTextInput(renderer.getWindow()); // Набір тексту шукає рівень
                 refreshLevelList(); // Оновлюємо список рівнів
+                prefetchNeighbours();
             }
             else if (selectedMenuItem == 1) { // Create Level
                 // Create a new level creator and run it
@@ -135,9 +325,16 @@ void Game::handleMainMenuInput(SDL_Event& e) {
                 if (creator.initialize()) {
                     creator.run();
                     // After creating a level, refresh the level list
+                    levelIndex.invalidate();
                     refreshLevelList();
                 }
             }
+            else if (selectedMenuItem == 2 && !generator) { // Generate Level
+                // Генеруємо пакет перевірених рівнів у фоні, меню лишається активним
+                generator = std::make_unique<LevelGenerator>(levelsPath, LevelGenerator::defaultSettings(std::random_device{}()));
+                generator->start();
+                updateGenerator();
+            }
             break;
         case SDLK_ESCAPE:
             SDL_Event quitEvent;
@@ -150,28 +347,66 @@ void Game::handleMainMenuInput(SDL_Event& e) {
 
 // Робота з вибором рівня
 void Game::handleLevelSelectInput(SDL_Event& e) {
+    if (e.type == SDL_EVENT_TEXT_INPUT) {
+        // Пробіл залишаємо для вибору рівня, решта символів доповнює пошук
+        std::string typed;
+        for (const char* c = e.text.text; *c; c++) {
+            if ((unsigned char)*c > ' ') typed.push_back(*c);
+        }
+        if (!typed.empty()) {
+            setSearchQuery(searchQuery + typed);
+        }
+        return;
+    }
+
     if (e.type == SDL_EVENT_KEY_DOWN) {
+        int count = (int)getLevelView().size();
+        int previousIndex = selectedLevelIndex;
+
         switch (e.key.key) {
         case SDLK_UP:
-            if (!levelFiles.empty()) {
-                selectedLevelIndex = (selectedLevelIndex - 1 + levelFiles.size()) % levelFiles.size();
-                audioManager.playSound("scroll"); // Play scroll sound
-            }
+            if (count > 0) selectLevel((selectedLevelIndex - 1 + count) % count);
             break;
         case SDLK_DOWN:
-            if (!levelFiles.empty()) {
-                selectedLevelIndex = (selectedLevelIndex + 1) % levelFiles.size();
-                audioManager.playSound("scroll"); // Play scroll sound
-            }
+            if (count > 0) selectLevel((selectedLevelIndex + 1) % count);
+            break;
+        case SDLK_PAGEUP:
+            selectLevel(selectedLevelIndex - MAX_VISIBLE_LEVELS);
+            break;
+        case SDLK_PAGEDOWN:
+            selectLevel(selectedLevelIndex + MAX_VISIBLE_LEVELS);
+            break;
+        case SDLK_HOME:
+            selectLevel(0);
             break;
+        case SDLK_END:
+            selectLevel(count - 1);
+            break;
+        case SDLK_BACKSPACE:
+            if (!searchQuery.empty()) {
+                setSearchQuery(searchQuery.substr(0, searchQuery.size() - 1));
+            }
+            return;
         case SDLK_RETURN: case SDLK_SPACE:
             audioManager.playSound("chose"); // Play chose sound
             // Завантаження вибраного рівня
             loadSelectedLevel();
-            break;
+            return;
         case SDLK_ESCAPE:
-            currentState = MENU; // Повернення до головного меню
-            break;
+            // Спочатку скидаємо пошук, повторний ESC - до головного меню
+            if (!searchQuery.empty()) {
+                setSearchQuery("");
+            }
+            else {
+                currentState = MENU; // Повернення до головного меню
+                SDL_StopTextInput(renderer.getWindow());
+            }
+            return;
+        }
+
+        if (selectedLevelIndex != previousIndex) {
+            audioManager.playSound("scroll"); // Play scroll sound
+            prefetchNeighbours();
         }
     }
 }
@@ -185,14 +420,11 @@ void Game::handleGameInput(SDL_Event& e) {
             case SDLK_ESCAPE:
                 currentState = MENU; // Повернення до головного меню
                 break;
-            case SDLK_R: // Перезапуск рівня
-                if (!levelFiles.empty()) {
-                    currentLevel->loadLevelFromFile(levelFiles[selectedLevelIndex]);
-                }
-                else {
-                    currentLevel->createDefaultLevel();
-                }
-                currentLevel->reset(); // Скидаємо стан рівня
+            case SDLK_R: // Перезапуск рівня з пам'яті, без повторного читання файлу
+                currentLevel->restart();
+                break;
+            case SDLK_Z: // Скасування останнього ходу
+                currentLevel->undoMove();
                 break;
             case SDLK_F: // Перемикання повноекранного режиму
                 renderer.toggleFullscreen();
@@ -221,18 +453,24 @@ void Game::handleGameInput(SDL_Event& e) {
             case SDLK_ESCAPE:
                 currentState = MENU; // Повернення до головного меню
                 break;
-            case SDLK_R: // Перезапуск рівня
-                if (!levelFiles.empty()) {
-                    currentLevel->loadLevelFromFile(levelFiles[selectedLevelIndex]);
-                }
-                else {
-                    currentLevel->createDefaultLevel();
-                }
-                currentLevel->reset(); // Скидаємо стан рівня
+            case SDLK_R: // Перезапуск рівня з пам'яті, без повторного читання файлу
+                currentLevel->restart();
                 break;
             case SDLK_F: // Перемикання повноекранного режиму
                 renderer.toggleFullscreen();
                 break;
+            case SDLK_O: // Підсвічування глухих кутів
+                renderer.toggleDoomedOverlay();
+                break;
+            case SDLK_H: // Підказка наступного ходу
+                renderer.toggleHint();
+                break;
+            case SDLK_Z: // Скасування ходу
+                currentLevel->undoMove();
+                break;
+            case SDLK_Y: // Повтор скасованого ходу
+                currentLevel->redoMove();
+                break;
             }
 
             // Перевіряємо умови перемоги чи поразки після руху
@@ -248,15 +486,36 @@ void Game::handleGameInput(SDL_Event& e) {
 
 // Обробка подій SDL
 void Game::handleEvents() {
+    TRACE_ZONE("Game::handleEvents");
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
+        // Рух миші нічого не змінює, решта подій може змінити картинку
+        if (e.type != SDL_EVENT_MOUSE_MOTION) {
+            frameDirty = true;
+        }
+
         if (e.type == SDL_EVENT_QUIT) {
             cleanup();
             exit(0);
         }
+        else if (e.type == SDL_EVENT_RENDER_DEVICE_RESET) {
+            // Текстури на відеокарті втрачено - їх буде створено заново
+            renderer.handleRenderReset();
+            thumbnails.releaseTexture();
+        }
+        else if (e.type == SDL_EVENT_RENDER_TARGETS_RESET) {
+            renderer.invalidateBoard(); // Вміст текстури поля втрачено
+        }
         else if (e.type == SDL_EVENT_WINDOW_RESIZED) {
             renderer.calculateScaling(currentLevel->getWidth(), currentLevel->getHeight());
         }
+        else if (e.type == SDL_EVENT_KEY_DOWN && e.key.key == SDLK_F3) {
+            profiler.toggleOverlay();
+        }
+        else if (e.type == SDL_EVENT_WINDOW_DISPLAY_CHANGED) {
+            // Інший дисплей може мати іншу частоту оновлення
+            framePacer.configure(renderer.isVSyncEnabled(), renderer.getRefreshRate());
+        }
         else {
             // Обробка введення відповідно до поточного стану
             switch (currentState) {
@@ -277,30 +536,85 @@ void Game::handleEvents() {
 // Основний цикл гри
 void Game::run() {
     bool quit = false;
+    TRACE_THREAD_NAME("main");
 
     while (!quit) {
+        profiler.beginFrame(renderer.getDrawCalls());
+
         // Отримуємо поточний час для анімацій
         Uint32 currentTime = SDL_GetTicks();
 
         // Оновлюємо анімації
-        currentLevel->updateAnimations(currentTime);
+        if (currentLevel->updateAnimations(currentTime) && currentState == GAME_PLAYING) {
+            frameDirty = true;
+        }
+        profiler.endPhase(FrameProfiler::PHASE_ANIMATIONS);
+
+        // Переносимо в кеш рівні, розібрані у фоні
+        prefetcher.collect(levelCache);
+        updateGenerator();
+
+        // Підхоплюємо файли, додані або видалені поки відкрито список
+        if (currentState == LEVEL_SELECT) {
+            levelIndex.update();
+            if (rebuildLevelList()) {
+                selectLevel(selectedLevelIndex);
+                frameDirty = true;
+            }
+
+            // Вивантажуємо готові мініатюри в атлас
+            if (thumbnails.upload(renderer.getRenderer())) {
+                frameDirty = true;
+            }
+        }
 
         // Обробка подій
+        profiler.beginPhase();
         handleEvents();
+        profiler.endPhase(FrameProfiler::PHASE_EVENTS);
 
-        // Відмальовуємо відповідно до поточного стану
-        switch (currentState) {
-        case MENU:
-            renderer.drawMainMenu(selectedMenuItem, menuItems);
-            break;
-        case LEVEL_SELECT:
-            renderer.drawLevelSelect(levelFiles, selectedLevelIndex, firstVisibleLevel);
-            break;
-        case GAME_PLAYING:
-            renderer.drawLevel(*currentLevel);
-            break;
+        // Незмінений кадр не перемальовуємо і не презентуємо
+        if (currentState != drawnState || profiler.isOverlayDue(SDL_GetTicksNS())) {
+            frameDirty = true;
+        }
+        bool presented = frameDirty;
+        if (frameDirty) {
+            switch (currentState) {
+            case MENU:
+                renderer.drawMainMenu(selectedMenuItem, menuItems);
+                break;
+            case LEVEL_SELECT:
+                renderer.drawLevelSelect(levelFiles, getLevelView(), selectedLevelIndex, firstVisibleLevel, searchQuery, thumbnails);
+                break;
+            case GAME_PLAYING:
+                renderer.drawLevel(*currentLevel);
+                break;
+            }
+            if (profiler.isOverlayVisible()) {
+                renderer.drawProfilerOverlay(profiler);
+                profiler.markOverlayDrawn(SDL_GetTicksNS());
+            }
+            profiler.endPhase(FrameProfiler::PHASE_DRAW);
+
+            renderer.present();
+            profiler.endPhase(FrameProfiler::PHASE_PRESENT);
+
+            frameDirty = false;
+            drawnState = currentState;
         }
+        else {
+            skippedFrames++;
+        }
+        profiler.endFrame(renderer.getDrawCalls(), currentLevel->getTrail().size(), presented);
 
-        SDL_Delay(16); // Приблизно 60 FPS
+        // Поки щось рухається - тримаємо частоту кадрів, інакше спимо до події
+        bool animating = false;
+        if (currentState == GAME_PLAYING) {
+            animating = currentLevel->isAnimating();
+        }
+        else if (currentState == LEVEL_SELECT) {
+            animating = thumbnails.isBusy();
+        }
+        framePacer.wait(animating, presented, IDLE_WAIT_TIMEOUT);
     }
 }
\ No newline at end of file
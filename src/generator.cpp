@@ -0,0 +1,190 @@
+#include "generator.h"
+#include "creator.h"
+#include "constants.h"
+#include "grid.h"
+#include "level.h"
+#include "solver.h"
+#include "trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+LevelGenerator::LevelGenerator(const std::string& outputPath, const GeneratorSettings& settings)
+    : outputPath(outputPath), settings(settings), threadCount(1),
+    nextLevel(0), generated(0), candidates(0), cancelled(false), finished(false) {
+    // Обмежуємо розміри правилами редактора рівнів
+    this->settings.minSize = std::clamp(settings.minSize, (int)LevelCreator::MIN_SIZE, (int)LevelCreator::MAX_SIZE);
+    this->settings.maxSize = std::clamp(settings.maxSize, this->settings.minSize, (int)LevelCreator::MAX_SIZE);
+    this->settings.maxPar = std::max(settings.minPar, settings.maxPar);
+
+    threadCount = settings.threadCount > 0 ? settings.threadCount : (int)std::thread::hardware_concurrency();
+    threadCount = std::clamp(threadCount, 1, std::max(1, settings.levelCount));
+}
+
+LevelGenerator::~LevelGenerator() {
+    cancel();
+}
+
+GeneratorSettings LevelGenerator::defaultSettings(unsigned int seed) {
+    GeneratorSettings defaults;
+    defaults.seed = seed;
+    defaults.levelCount = 10;
+    defaults.minPar = 6;
+    defaults.maxPar = 14;
+    defaults.minSize = LevelCreator::MIN_SIZE;
+    defaults.maxSize = 16;
+    defaults.wallDensity = 0.18f;
+    defaults.trapDensity = 0.04f;
+    defaults.threadCount = 0;
+    defaults.maxAttempts = 200000;
+    defaults.namePrefix = "gen";
+    return defaults;
+}
+
+bool LevelGenerator::generateLevel(int levelIndex, long long& candidates) {
+    // Кожен рівень має власне зерно, тому результат не залежить від кількості потоків
+    std::seed_seq seedSequence{ settings.seed, (unsigned int)levelIndex };
+    std::mt19937 rng(seedSequence);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+    Level level(outputPath);
+    LevelSolver solver;
+    Grid grid;
+
+    for (int attempt = 0; attempt < settings.maxAttempts; attempt++) {
+        // Скасування перевіряємо між кандидатами - один кандидат триває мікросекунди
+        if (cancelled.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        candidates++;
+
+        // Розміри з урахуванням допустимих пропорцій
+        int width = std::uniform_int_distribution<int>(settings.minSize, settings.maxSize)(rng);
+        int minHeight = std::max(settings.minSize, (int)std::ceil(width / LevelCreator::MAX_RATIO));
+        int maxHeight = std::min(settings.maxSize, (int)std::floor(width * LevelCreator::MAX_RATIO));
+        int height = std::uniform_int_distribution<int>(minHeight, maxHeight)(rng);
+
+        // Стіни по периметру, випадкові стіни і пастки всередині
+        grid.resize(width, height, EMPTY);
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                if (x == 0 || y == 0 || x == width - 1 || y == height - 1) {
+                    grid.at(x, y) = WALL;
+                    continue;
+                }
+                float roll = chance(rng);
+                if (roll < settings.wallDensity) {
+                    grid.at(x, y) = WALL;
+                }
+                else if (roll < settings.wallDensity + settings.trapDensity) {
+                    grid.at(x, y) = TRAP;
+                }
+            }
+        }
+
+        // Старт і фініш у різних вільних клітинках
+        std::uniform_int_distribution<int> randomX(1, width - 2);
+        std::uniform_int_distribution<int> randomY(1, height - 2);
+        int startX = randomX(rng), startY = randomY(rng);
+        int finishX = randomX(rng), finishY = randomY(rng);
+        if (grid.at(startX, startY) != EMPTY || grid.at(finishX, finishY) != EMPTY ||
+            (startX == finishX && startY == finishY)) {
+            continue;
+        }
+        grid.at(startX, startY) = START;
+        grid.at(finishX, finishY) = FINISH;
+
+        // Залишаємо лише рівні з потрібною складністю
+        level.loadLevelData(grid, startX, startY);
+        SolveResult result = solver.solve(level);
+        if (!result.solvable || result.par < settings.minPar || result.par > settings.maxPar) {
+            continue;
+        }
+
+        std::string filePath = outputPath + "/" + settings.namePrefix + "_" +
+            std::to_string(settings.seed) + "_" + std::to_string(levelIndex) + ".bin";
+        return Level::saveLevelToFile(filePath, grid, startX, startY);
+    }
+
+    return false;
+}
+
+void LevelGenerator::reset() {
+    nextLevel = 0;
+    generated = 0;
+    candidates = 0;
+    cancelled = false;
+    finished = false;
+    startTime = std::chrono::steady_clock::now();
+}
+
+void LevelGenerator::generate() {
+    // Потоки розбирають номери рівнів з спільного лічильника
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadCount; i++) {
+        workers.emplace_back([this]() {
+            TRACE_THREAD_NAME("generator");
+            for (int index = nextLevel++; index < settings.levelCount && !cancelled; index = nextLevel++) {
+                // Кандидатів додаємо після кожного рівня, щоб швидкість було видно під час роботи
+                long long localCandidates = 0;
+                if (generateLevel(index, localCandidates)) {
+                    generated++;
+                }
+                candidates += localCandidates;
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    endTime = std::chrono::steady_clock::now();
+    finished.store(true, std::memory_order_release);
+
+    GeneratorStats stats = getStats();
+    cout << "Generated " << stats.levelsGenerated << " levels (" << stats.candidatesTried
+        << " candidates) on " << threadCount << " threads in " << stats.seconds << " s: "
+        << stats.levelsPerSecond << " levels/s, " << stats.candidatesPerSecond << " candidates/s"
+        << (cancelled ? " (cancelled)" : "") << endl;
+}
+
+GeneratorStats LevelGenerator::run() {
+    cancel();
+    reset();
+    generate();
+    return getStats();
+}
+
+void LevelGenerator::start() {
+    cancel();
+    reset();
+    thread = std::thread(&LevelGenerator::generate, this);
+}
+
+void LevelGenerator::cancel() {
+    if (thread.joinable()) {
+        cancelled = true;
+        thread.join();
+    }
+}
+
+GeneratorStats LevelGenerator::getStats() const {
+    GeneratorStats stats = { 0, 0, 0.0, 0.0, 0.0 };
+
+    auto now = isFinished() ? endTime : std::chrono::steady_clock::now();
+    stats.seconds = std::chrono::duration<double>(now - startTime).count();
+    stats.levelsGenerated = generated;
+    stats.candidatesTried = candidates;
+    if (stats.seconds > 0.0) {
+        stats.levelsPerSecond = stats.levelsGenerated / stats.seconds;
+        stats.candidatesPerSecond = stats.candidatesTried / stats.seconds;
+    }
+    return stats;
+}
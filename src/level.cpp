@@ -1,6 +1,8 @@
 #include "level.h"
 #include "constants.h"
 #include "utils.h"
+#include "levelpack.h"
+#include "trace.h"
 #include <iostream>
 #include <algorithm>
 #include <filesystem>
@@ -10,8 +12,8 @@ namespace fs = std::filesystem;
 using namespace std;
 
 Level::Level(const std::string& levelsDirectory)
-    : width(0), height(0), playerX(0), playerY(0), levelsPath(levelsDirectory),
-    isFinished(false), isFailed(false), animationRadius(0), lastAnimationTime(0) {
+    : playerX(0), playerY(0), startX(0), startY(0), levelsPath(levelsDirectory),
+    isFinished(false), isFailed(false), animationRadius(0), lastAnimationTime(0), attemptCount(0) {
     utils::ensureDirectoryExists(levelsPath);
 }
 
@@ -20,46 +22,57 @@ Level::~Level() {
 }
 
 char Level::getTileAt(int x, int y) const {
-    if (x >= 0 && x < width && y >= 0 && y < height) {
-        return levelData[y][x];
+    if (levelData.inBounds(x, y)) {
+        return levelData.at(x, y);
     }
     return WALL; // За межами - вважаємо стіною
 }
 
-std::vector<std::string> Level::getLevelFileList() {
-    std::vector<std::string> levelFiles;
+int Level::getSlideTarget(int x, int y, int direction) const {
+    if (!levelData.inBounds(x, y) || direction < 0 || direction >= DIR_COUNT) {
+        return -1;
+    }
+    return slideTargets[levelData.index(x, y) * DIR_COUNT + direction];
+}
 
-    try {
-        // Перевіряємо чи існує директорія
-        if (!fs::exists(levelsPath)) {
-            fs::create_directories(levelsPath);
-            cout << "Created levels directory: " << levelsPath << endl;
-            return levelFiles;
+void Level::buildSlideTables() {
+    int width = levelData.getWidth();
+    int height = levelData.getHeight();
+    int stride = levelData.getStride();
+    slideTargets.assign(levelData.getCellCount() * DIR_COUNT, 0);
+
+    // Для кожного напрямку проходимо рядок/стовпець назустріч руху:
+    // клітинка перед перешкодою зупиняє сама себе, інші успадковують
+    // точку зупинки від сусіда в напрямку руху
+    for (int y = 0; y < height; y++) {
+        for (int x = width - 1; x >= 0; x--) {
+            int cell = levelData.index(x, y);
+            slideTargets[cell * DIR_COUNT + DIR_RIGHT] =
+                isObstacle(x + 1, y) ? cell : slideTargets[(cell + 1) * DIR_COUNT + DIR_RIGHT];
         }
-
-        // Отримуємо список .bin файлів
-        for (const auto& entry : fs::directory_iterator(levelsPath)) {
-            if (entry.path().extension() == ".bin") {
-                levelFiles.push_back(entry.path().filename().string());
-                cout << "Found level: " << entry.path().filename().string() << endl;
-            }
+        for (int x = 0; x < width; x++) {
+            int cell = levelData.index(x, y);
+            slideTargets[cell * DIR_COUNT + DIR_LEFT] =
+                isObstacle(x - 1, y) ? cell : slideTargets[(cell - 1) * DIR_COUNT + DIR_LEFT];
         }
-
-        // Сортуємо список
-        std::sort(levelFiles.begin(), levelFiles.end());
-        cout << "Total levels found: " << levelFiles.size() << endl;
-    }
-    catch (const fs::filesystem_error& e) {
-        cerr << "Error accessing directory: " << e.what() << endl;
     }
 
-    return levelFiles;
+    for (int x = 0; x < width; x++) {
+        for (int y = height - 1; y >= 0; y--) {
+            int cell = levelData.index(x, y);
+            slideTargets[cell * DIR_COUNT + DIR_DOWN] =
+                isObstacle(x, y + 1) ? cell : slideTargets[(cell + stride) * DIR_COUNT + DIR_DOWN];
+        }
+        for (int y = 0; y < height; y++) {
+            int cell = levelData.index(x, y);
+            slideTargets[cell * DIR_COUNT + DIR_UP] =
+                isObstacle(x, y - 1) ? cell : slideTargets[(cell - stride) * DIR_COUNT + DIR_UP];
+        }
+    }
 }
 
-bool Level::loadLevelFromFile(const std::string& filename) {
-    std::string filePath = levelsPath + "\\" + filename;
-
-    cout << "Loading level: " << filePath << endl;
+bool Level::readLevelFile(const std::string& filePath, Grid& grid, int& startX, int& startY) {
+    TRACE_ZONE("Level::readLevelFile");
     std::ifstream inFile(filePath, std::ios::binary | std::ios::in);
 
     if (!inFile) {
@@ -68,48 +81,158 @@ bool Level::loadLevelFromFile(const std::string& filename) {
     }
 
     // Зчитуємо розміри рівня
+    int width = 0, height = 0;
     inFile.read(reinterpret_cast<char*>(&width), sizeof(width));
     inFile.read(reinterpret_cast<char*>(&height), sizeof(height));
 
     // Перевіряємо, чи розміри знаходяться в розумних межах
-    if (width <= 0 || width > 100 || height <= 0 || height > 100) {
+    if (!inFile || width <= 0 || width > 100 || height <= 0 || height > 100) {
         cerr << "Invalid level dimensions: " << width << "x" << height << endl;
         return false;
     }
 
-    // Очищаємо існуючий рівень і створюємо новий
-    levelData.clear();
-    levelData.resize(height, std::vector<char>(width));
+    // Перевикористовуємо буфер сітки і зчитуємо всі клітинки одним блоком
+    grid.resize(width, height, EMPTY);
+    std::span<char> cells = grid.data();
+    inFile.read(cells.data(), cells.size());
 
-    // Зчитуємо дані рівня
-    for (int i = 0; i < height; i++) {
-        char rowBuffer[100]; // Достатній буфер
-        inFile.read(rowBuffer, width);
-        for (int j = 0; j < width; j++) {
-            levelData[i][j] = rowBuffer[j];
+    // Зчитуємо позицію гравця
+    inFile.read(reinterpret_cast<char*>(&startX), sizeof(startX));
+    inFile.read(reinterpret_cast<char*>(&startY), sizeof(startY));
+
+    // Обрізаний файл не повинен дати рівень зі сміттям у клітинках
+    if (!inFile) {
+        cerr << "Truncated level file: " << filePath << endl;
+        return false;
+    }
+
+    if (!grid.inBounds(startX, startY) || grid.at(startX, startY) == WALL) {
+        cerr << "Invalid start position " << startX << "," << startY << " in level file: " << filePath << endl;
+        return false;
+    }
+
+    return true;
+}
+
+void Level::buildReachability() {
+    int cellCount = levelData.getCellCount();
+    finishReachable.assign(cellCount, false);
+    finishDistance.assign(cellCount, -1);
+    hintDirections.assign(cellCount, -1);
+
+    // Зворотні ребра графа ковзань у компактному вигляді: для клітинки cell
+    // reverseEdges[reverseOffsets[cell] .. reverseOffsets[cell + 1]) містить
+    // пари (попередник * DIR_COUNT + напрямок)
+    reverseOffsets.assign(cellCount + 1, 0);
+    for (int cell = 0; cell < cellCount; cell++) {
+        if (levelData[cell] == WALL) continue;
+        for (int dir = 0; dir < DIR_COUNT; dir++) {
+            int target = slideTargets[cell * DIR_COUNT + dir];
+            if (target != cell) reverseOffsets[target + 1]++;
         }
     }
+    for (int cell = 0; cell < cellCount; cell++) {
+        reverseOffsets[cell + 1] += reverseOffsets[cell];
+    }
 
-    // Зчитуємо позицію гравця
-    inFile.read(reinterpret_cast<char*>(&playerX), sizeof(playerX));
-    inFile.read(reinterpret_cast<char*>(&playerY), sizeof(playerY));
+    reverseEdges.resize(reverseOffsets[cellCount]);
+    std::vector<int> fill(reverseOffsets.begin(), reverseOffsets.end() - 1);
+    for (int cell = 0; cell < cellCount; cell++) {
+        if (levelData[cell] == WALL) continue;
+        for (int dir = 0; dir < DIR_COUNT; dir++) {
+            int target = slideTargets[cell * DIR_COUNT + dir];
+            if (target != cell) reverseEdges[fill[target]++] = cell * DIR_COUNT + dir;
+        }
+    }
 
-    inFile.close();
+    // Зворотний пошук у ширину від усіх фінішів: клітинка досяжна, якщо
+    // з неї можна зупинитися на фініші або на іншій досяжній клітинці.
+    // Перше відкриття клітинки дає найкоротшу відстань і оптимальний напрямок.
+    std::vector<int> queue;
+    queue.reserve(cellCount);
+    for (int cell = 0; cell < cellCount; cell++) {
+        if (levelData[cell] == FINISH) {
+            finishReachable[cell] = true;
+            finishDistance[cell] = 0;
+            queue.push_back(cell);
+        }
+    }
 
-    // Скидаємо стан гри при завантаженні нового рівня
-    reset();
+    for (size_t head = 0; head < queue.size(); head++) {
+        int cell = queue[head];
+        for (int edge = reverseOffsets[cell]; edge < reverseOffsets[cell + 1]; edge++) {
+            int source = reverseEdges[edge] / DIR_COUNT;
+            // З пастки чи фінішу далі не рухаються - вони кінцеві стани
+            if (finishReachable[source] || levelData[source] == TRAP || levelData[source] == FINISH) continue;
+            finishReachable[source] = true;
+            finishDistance[source] = finishDistance[cell] + 1;
+            hintDirections[source] = static_cast<signed char>(reverseEdges[edge] % DIR_COUNT);
+            queue.push_back(source);
+        }
+    }
+}
 
-    cout << "Loaded level: " << width << "x" << height << ", player at (" << playerX << ", " << playerY << ")" << endl;
-    return true;
+int Level::getFinishDistance(int x, int y) const {
+    if (!levelData.inBounds(x, y)) return -1;
+    return finishDistance[levelData.index(x, y)];
+}
+
+int Level::getHintDirection() const {
+    if (isFinished || isFailed || !levelData.inBounds(playerX, playerY)) return -1;
+    return hintDirections[levelData.index(playerX, playerY)];
+}
+
+bool Level::isCellDoomed(int x, int y) const {
+    if (!levelData.inBounds(x, y) || levelData.at(x, y) == WALL) {
+        return false; // На стіні зупинитися неможливо
+    }
+    return !finishReachable[levelData.index(x, y)];
+}
+
+void Level::buildRevealRings() {
+    int cellCount = levelData.getCellCount();
+    revealRing.resize(cellCount);
+
+    // Номер кільця - ціла частина евклідової відстані до гравця
+    int ringCount = 0;
+    for (int cell = 0; cell < cellCount; cell++) {
+        int distX = levelData.indexX(cell) - playerX;
+        int distY = levelData.indexY(cell) - playerY;
+        int squared = distX * distX + distY * distY;
+        int ring = static_cast<int>(sqrt(squared));
+        while (ring * ring > squared) ring--;
+        while ((ring + 1) * (ring + 1) <= squared) ring++;
+
+        revealRing[cell] = ring;
+        ringCount = max(ringCount, ring + 1);
+    }
+
+    // Групуємо клітинки за кільцями підрахунком
+    revealOffsets.assign(ringCount + 1, 0);
+    for (int cell = 0; cell < cellCount; cell++) {
+        revealOffsets[revealRing[cell] + 1]++;
+    }
+    for (int ring = 0; ring < ringCount; ring++) {
+        revealOffsets[ring + 1] += revealOffsets[ring];
+    }
+
+    revealCells.resize(cellCount);
+    std::vector<int> fill(revealOffsets.begin(), revealOffsets.end() - 1);
+    for (int cell = 0; cell < cellCount; cell++) {
+        revealCells[fill[revealRing[cell]]++] = cell;
+    }
+}
+
+std::string Level::getLevelPath(const std::string& filename) const {
+    return levelsPath + "\\" + filename;
 }
 
 void Level::createDefaultLevel() {
     cout << "Creating default level" << endl;
-    width = 8;
-    height = 9;
+    const int width = 8;
+    const int height = 9;
 
-    levelData.clear();
-    levelData.resize(height, std::vector<char>(width));
+    levelData.resize(width, height, EMPTY);
 
     // Заповнюємо рівень за замовчуванням
     const char defaultLevel[9][8] = {
@@ -125,13 +248,14 @@ void Level::createDefaultLevel() {
     };
 
     for (int i = 0; i < height; i++) {
-        for (int j = 0; j < width; j++) {
-            levelData[i][j] = defaultLevel[i][j];
-        }
+        std::copy(defaultLevel[i], defaultLevel[i] + width, levelData.row(i).begin());
     }
 
-    playerX = 1;
-    playerY = 7;
+    startX = playerX = 1;
+    startY = playerY = 7;
+
+    buildSlideTables();
+    buildReachability();
 
     // Скидаємо стан гри при створенні нового рівня
     reset();
@@ -139,111 +263,219 @@ void Level::createDefaultLevel() {
     cout << "Default level created" << endl;
 }
 
+void Level::loadLevelData(const Grid& grid, int startX, int startY) {
+    TRACE_ZONE("Level::loadLevelData");
+    // Тихе завантаження вже розібраного рівня (генератор, пакетна перевірка)
+    levelData = grid;
+    this->startX = playerX = startX;
+    this->startY = playerY = startY;
+
+    buildSlideTables();
+    buildReachability();
+    resetState();
+}
+
+bool Level::loadLevelFromPack(const LevelPack& pack, int index) {
+    TRACE_ZONE("Level::loadLevelFromPack");
+    if (!pack.isOpen() || index < 0 || index >= pack.getLevelCount()) {
+        return false;
+    }
+
+    // Тайли копіюються прямо з відображеного в пам'ять пакета
+    const LevelPack::IndexEntry& entry = pack.getEntry(index);
+    std::span<const char> tiles = pack.getTiles(index);
+    levelData.resize(entry.width, entry.height, EMPTY);
+    std::copy(tiles.begin(), tiles.end(), levelData.data().begin());
+
+    startX = playerX = entry.startX;
+    startY = playerY = entry.startY;
+
+    buildSlideTables();
+    buildReachability();
+    resetState();
+
+    cout << "Loaded level from pack: " << pack.getName(index) << " (" << getWidth() << "x" << getHeight() << ")" << endl;
+    return true;
+}
+
+bool Level::saveLevelToFile(const std::string& filePath, const Grid& grid, int startX, int startY) {
+    std::ofstream outFile(filePath, std::ios::binary | std::ios::out);
+
+    if (!outFile) {
+        cerr << "Failed to open file for writing: " << filePath << endl;
+        return false;
+    }
+
+    // Розміри рівня
+    int width = grid.getWidth();
+    int height = grid.getHeight();
+    outFile.write(reinterpret_cast<const char*>(&width), sizeof(width));
+    outFile.write(reinterpret_cast<const char*>(&height), sizeof(height));
+
+    // Дані рівня одним блоком
+    std::span<const char> cells = grid.data();
+    outFile.write(cells.data(), cells.size());
+
+    // Позиція гравця
+    outFile.write(reinterpret_cast<const char*>(&startX), sizeof(startX));
+    outFile.write(reinterpret_cast<const char*>(&startY), sizeof(startY));
+
+    return outFile.good();
+}
+
 bool Level::isObstacle(int x, int y) const {
     // Перевіряємо чи координати в межах поля і чи це не стіна
-    if (x < 0 || x >= width || y < 0 || y >= height) {
+    if (!levelData.inBounds(x, y)) {
         return true; // За межами поля вважаємо перешкодою
     }
-    return levelData[y][x] == WALL;
+    return levelData.at(x, y) == WALL;
 }
 
 void Level::movePlayer(char direction) {
+    TRACE_ZONE("Level::movePlayer");
     if (isFinished || isFailed) return; // Якщо гра закінчена, рух неможливий
 
-    int newX = playerX, newY = playerY;
-
-    // Використовуємо напрямок руху для визначення інкременту
-    int dx = 0, dy = 0;
-
-    switch (direction) {
-    case 'w': // Вгору
-        dy = -1;
-        break;
-    case 's': // Вниз
-        dy = 1;
-        break;
-    case 'a': // Вліво
-        dx = -1;
-        break;
-    case 'd': // Вправо
-        dx = 1;
-        break;
-    default:
+    // Визначаємо напрямок руху
+    const char* key = std::find(DIRECTION_KEYS, DIRECTION_KEYS + DIR_COUNT, direction);
+    if (key == DIRECTION_KEYS + DIR_COUNT) {
         return; // Невідомий напрямок - нічого не робимо
     }
+    int dir = static_cast<int>(key - DIRECTION_KEYS);
 
-    // Зберігаємо початкову позицію
-    int startX = playerX;
-    int startY = playerY;
+    // Записуємо в журнал лише ходи, що змінили позицію
+    int cellBefore = levelData.inBounds(playerX, playerY) ? levelData.index(playerX, playerY) : -1;
+    if (applyMove(dir)) {
+        moveLog.record(dir, cellBefore);
+    }
+}
 
-    // Ковзаємо поки не зустрінемо перешкоду
-    while (!isObstacle(newX + dx, newY + dy)) {
-        newX += dx;
-        newY += dy;
+bool Level::applyMove(int dir) {
+    // Точка зупинки береться з попередньо побудованої таблиці
+    int target = getSlideTarget(playerX, playerY, dir);
+    if (target < 0) return false;
 
-        // Додаємо клітинку до сліду
-        Uint32 currentTime = SDL_GetTicks();
-        trail.push_back({ newX, newY, currentTime });
-    }
+    int newX = levelData.indexX(target);
+    int newY = levelData.indexY(target);
 
     // Оновлюємо позицію тільки якщо вона змінилась
-    if (newX != playerX || newY != playerY) {
-        playerX = newX;
-        playerY = newY;
-
-        // Перевіряємо умови перемоги чи поразки
-        if (levelData[playerY][playerX] == TRAP) {
-            isFailed = true;
-            animationRadius = 0;
-            lastAnimationTime = SDL_GetTicks();
-            cout << "Player trapped! Game over!" << endl;
-        }
-        else if (levelData[playerY][playerX] == FINISH) {
-            isFinished = true;
-            animationRadius = 0;
-            lastAnimationTime = SDL_GetTicks();
-            cout << "Player reached finish! Level completed!" << endl;
-        }
+    if (newX == playerX && newY == playerY) {
+        return false;
+    }
+
+    // Весь шлях ковзання додаємо до сліду одним сегментом
+    Uint32 currentTime = SDL_GetTicks();
+    trail.add({ playerX + DIRECTION_DX[dir], playerY + DIRECTION_DY[dir], newX, newY, currentTime });
+
+    playerX = newX;
+    playerY = newY;
+
+    // Перевіряємо умови перемоги чи поразки
+    if (levelData.at(playerX, playerY) == TRAP) {
+        endAttempt(false);
+        cout << "Player trapped! Game over!" << endl;
     }
+    else if (levelData.at(playerX, playerY) == FINISH) {
+        endAttempt(true);
+        cout << "Player reached finish! Level completed!" << endl;
+    }
+    else if (isCellDoomed(playerX, playerY)) {
+        // З цієї клітинки фініш уже недосяжний - завершуємо спробу одразу
+        endAttempt(false);
+        cout << "Player reached a dead end! Game over!" << endl;
+    }
+
+    return true;
 }
 
-void Level::reset() {
+bool Level::undoMove() {
+    if (!moveLog.canUndo()) return false;
+
+    // Відновлюємо позицію перед останнім ходом: від найближчої контрольної
+    // точки повторюємо не більше CHECKPOINT_INTERVAL ходів за таблицею зупинок
+    int index = moveLog.getCursor() - 1;
+    int cell = moveLog.getCheckpointCell(index);
+    for (int i = MoveLog::checkpointStart(index); i < index; i++) {
+        cell = slideTargets[cell * DIR_COUNT + moveLog.getMove(i)];
+    }
+    moveLog.stepBack();
+
+    playerX = levelData.indexX(cell);
+    playerY = levelData.indexY(cell);
+
+    // Скасування повертає гравця в гру навіть після перемоги чи поразки
     isFinished = false;
     isFailed = false;
     animationRadius = 0;
     lastAnimationTime = 0;
-    trail.clear();
+    return true;
+}
+
+bool Level::redoMove() {
+    if (isFinished || isFailed || !moveLog.canRedo()) return false;
+
+    int dir = moveLog.getMove(moveLog.getCursor());
+    moveLog.stepForward();
+    applyMove(dir);
+    return true;
+}
+
+void Level::reset() {
+    resetState();
     cout << "Level state reset" << endl;
 }
 
-void Level::updateAnimations(Uint32 currentTime) {
-    // Оновлення сліду - видалення старих точок
-    auto it = trail.begin();
-    while (it != trail.end()) {
-        if (currentTime - it->timeCreated > TRAIL_LIFETIME) {
-            it = trail.erase(it);
-        }
-        else {
-            ++it;
-        }
-    }
+void Level::restart() {
+    // Сітка під час гри не змінюється, тому перезапуск - це лише
+    // повернення гравця на старт і скидання змінного стану
+    playerX = startX;
+    playerY = startY;
+    resetState();
+}
 
-    // Оновлення анімації перемоги/поразки
-    if ((isFinished || isFailed) && currentTime - lastAnimationTime >= ANIMATION_STEP_TIME) {
+void Level::endAttempt(bool finished) {
+    isFinished = finished;
+    isFailed = !finished;
+    attemptCount++;
+    animationRadius = 0;
+    lastAnimationTime = SDL_GetTicks();
+    buildRevealRings();
+}
+
+void Level::resetState() {
+    isFinished = false;
+    isFailed = false;
+    animationRadius = 0;
+    lastAnimationTime = 0;
+    trail.reset(getWidth(), getHeight());
+    moveLog.clear();
+}
+
+bool Level::updateAnimations(Uint32 currentTime) {
+    TRACE_ZONE("Level::updateAnimations");
+    // Живий слід згасає з кожним кадром, а зникнення останнього сегмента теж видно
+    bool changed = !trail.empty();
+
+    // Оновлення сліду - видалення старих сегментів з початку кільця
+    trail.expire(currentTime, TRAIL_LIFETIME);
+
+    // Оновлення анімації перемоги/поразки: радіус росте, доки не відкриються всі кільця
+    bool revealing = (isFinished || isFailed) && animationRadius + 1 < getRevealRingCount();
+    if (revealing && currentTime - lastAnimationTime >= ANIMATION_STEP_TIME) {
         animationRadius++;
         lastAnimationTime = currentTime;
+        changed = true;
 
         // Для діагностики - можна бачити прогрес анімації
         if (animationRadius % 5 == 0) {
             cout << "Animation radius: " << animationRadius << endl;
         }
-
-        // Обмеження радіусу анімації, щоб не зростав нескінченно
-        int maxRadius = (int)sqrt(width * width + height * height) + 1;
-        if (animationRadius > maxRadius) {
-            animationRadius = maxRadius;
-        }
     }
+    return changed;
+}
+
+bool Level::isAnimating() const {
+    if (!trail.empty()) return true;
+    return (isFinished || isFailed) && animationRadius + 1 < getRevealRingCount();
 }
 
 int Level::getAnimationRadius() const {
@@ -0,0 +1,96 @@
+#include "levelcache.h"
+#include <iostream>
+
+using namespace std;
+
+LevelCache::LevelCache(size_t memoryLimit)
+    : memoryLimit(memoryLimit), memoryUsed(0), hits(0), misses(0), evictions(0) {
+}
+
+size_t LevelCache::entrySize(const std::string& filePath, const Entry& entry) {
+    return sizeof(Entry) + filePath.size() + entry.grid.data().size();
+}
+
+bool LevelCache::statFile(const std::string& filePath, Uint64& fileSize, SDL_Time& modifyTime) {
+    SDL_PathInfo info;
+    if (!SDL_GetPathInfo(filePath.c_str(), &info) || info.type != SDL_PATHTYPE_FILE) {
+        return false;
+    }
+    fileSize = info.size;
+    modifyTime = info.modify_time;
+    return true;
+}
+
+bool LevelCache::load(const std::string& filePath, Level& level) {
+    Uint64 fileSize = 0;
+    SDL_Time modifyTime = 0;
+    if (!statFile(filePath, fileSize, modifyTime)) {
+        cerr << "Failed to open level file: " << filePath << endl;
+        return false;
+    }
+
+    // Влучання: файл не змінився з моменту розбору
+    auto found = index.find(filePath);
+    if (found != index.end()) {
+        const Entry& entry = found->second->second;
+        if (entry.fileSize == fileSize && entry.modifyTime == modifyTime) {
+            hits++;
+            entries.splice(entries.begin(), entries, found->second);
+            level.loadLevelData(entry.grid, entry.startX, entry.startY);
+            return true;
+        }
+    }
+
+    // Промах: читаємо файл і запам'ятовуємо результат
+    misses++;
+    Entry entry;
+    entry.fileSize = fileSize;
+    entry.modifyTime = modifyTime;
+    if (!Level::readLevelFile(filePath, entry.grid, entry.startX, entry.startY)) {
+        return false;
+    }
+
+    level.loadLevelData(entry.grid, entry.startX, entry.startY);
+    insert(filePath, std::move(entry));
+    return true;
+}
+
+void LevelCache::insert(const std::string& filePath, Entry entry) {
+    auto found = index.find(filePath);
+    if (found != index.end()) {
+        memoryUsed -= entrySize(filePath, found->second->second);
+        entries.erase(found->second);
+        index.erase(found);
+    }
+
+    size_t size = entrySize(filePath, entry);
+    if (size > memoryLimit) {
+        return; // Запис більший за весь кеш - не зберігаємо
+    }
+
+    entries.emplace_front(filePath, std::move(entry));
+    index[filePath] = entries.begin();
+    memoryUsed += size;
+    evictToLimit();
+}
+
+void LevelCache::evictToLimit() {
+    while (memoryUsed > memoryLimit && !entries.empty()) {
+        auto& oldest = entries.back();
+        memoryUsed -= entrySize(oldest.first, oldest.second);
+        index.erase(oldest.first);
+        entries.pop_back();
+        evictions++;
+    }
+}
+
+void LevelCache::clear() {
+    entries.clear();
+    index.clear();
+    memoryUsed = 0;
+}
+
+void LevelCache::setMemoryLimit(size_t limit) {
+    memoryLimit = limit;
+    evictToLimit();
+}
@@ -0,0 +1,147 @@
+// Пакетна перевірка рівнів: розв'язує кожен .bin файл у директорії
+// на пулі потоків і виводить по одному рядку CSV або JSON на рівень.
+//
+// Використання: levelcheck <levels-directory> [--json] [--threads N]
+
+#include "level.h"
+#include "solver.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+using namespace std;
+
+// Результат перевірки одного рівня
+struct LevelReport {
+    std::string name;
+    bool valid;
+    int width;
+    int height;
+    SolveResult solve;
+    double solveMicroseconds;
+};
+
+// Екранування імені файлу для JSON
+static std::string escapeJson(const std::string& text) {
+    std::string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') escaped += '\\';
+        escaped += c;
+    }
+    return escaped;
+}
+
+static void printReport(const LevelReport& report, bool json) {
+    if (json) {
+        cout << "{\"file\":\"" << escapeJson(report.name) << "\",\"width\":" << report.width
+            << ",\"height\":" << report.height << ",\"valid\":" << (report.valid ? "true" : "false")
+            << ",\"solvable\":" << (report.solve.solvable ? "true" : "false")
+            << ",\"par\":" << report.solve.par << ",\"reachable_stops\":" << report.solve.reachableStops
+            << ",\"solve_us\":" << report.solveMicroseconds << "}\n";
+    }
+    else {
+        cout << report.name << "," << report.width << "," << report.height << ","
+            << (report.valid ? "true" : "false") << "," << (report.solve.solvable ? "true" : "false") << ","
+            << report.solve.par << "," << report.solve.reachableStops << "," << report.solveMicroseconds << "\n";
+    }
+}
+
+int main(int argc, char* argv[]) {
+    std::string levelsPath;
+    bool json = false;
+    int threadCount = (int)std::thread::hardware_concurrency();
+
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        }
+        else if (arg == "--threads" && i + 1 < argc) {
+            threadCount = std::atoi(argv[++i]);
+        }
+        else {
+            levelsPath = arg;
+        }
+    }
+
+    if (levelsPath.empty()) {
+        cerr << "Usage: levelcheck <levels-directory> [--json] [--threads N]" << endl;
+        return 1;
+    }
+
+    // Збираємо список рівнів
+    std::vector<fs::path> files;
+    try {
+        for (const auto& entry : fs::directory_iterator(levelsPath)) {
+            if (entry.path().extension() == ".bin") {
+                files.push_back(entry.path());
+            }
+        }
+    }
+    catch (const fs::filesystem_error& e) {
+        cerr << "Error accessing directory: " << e.what() << endl;
+        return 1;
+    }
+    std::sort(files.begin(), files.end());
+
+    std::vector<LevelReport> reports(files.size());
+    std::atomic<size_t> nextFile(0);
+    threadCount = std::clamp(threadCount, 1, std::max(1, (int)files.size()));
+
+    auto startTime = std::chrono::steady_clock::now();
+
+    // Кожен потік має власні рівень, сітку і розв'язувач - спільним є лише лічильник
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&]() {
+            Level level(levelsPath);
+            LevelSolver solver;
+            Grid grid;
+
+            for (size_t i = nextFile++; i < files.size(); i = nextFile++) {
+                LevelReport& report = reports[i];
+                report.name = files[i].filename().string();
+                report.solve = { false, -1, 0, "" };
+                report.solveMicroseconds = 0.0;
+
+                int startX = 0, startY = 0;
+                report.valid = Level::readLevelFile(files[i].string(), grid, startX, startY);
+                report.width = report.valid ? grid.getWidth() : 0;
+                report.height = report.valid ? grid.getHeight() : 0;
+                if (!report.valid) continue;
+
+                auto solveStart = std::chrono::steady_clock::now();
+                level.loadLevelData(grid, startX, startY);
+                report.solve = solver.solve(level);
+                report.solveMicroseconds = std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - solveStart).count();
+            }
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    // Виводимо результати в порядку імен файлів
+    if (!json) {
+        cout << "file,width,height,valid,solvable,par,reachable_stops,solve_us\n";
+    }
+    int solvableCount = 0;
+    for (const auto& report : reports) {
+        printReport(report, json);
+        if (report.solve.solvable) solvableCount++;
+    }
+    cout.flush();
+
+    cerr << "Checked " << reports.size() << " levels (" << solvableCount << " solvable) on "
+        << threadCount << " threads in " << seconds << " s" << endl;
+    return 0;
+}
@@ -0,0 +1,246 @@
+#include "levelindex.h"
+#include "trace.h"
+#include "utils.h"
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace fs = std::filesystem;
+using namespace std;
+
+static bool isLevelFileName(const std::string& name) {
+    return fs::path(name).extension() == ".bin";
+}
+
+LevelIndex::LevelIndex(const std::string& levelsPath)
+    : levelsPath(levelsPath), version(0), lastScanTime(0), needsRescan(true), inotifyFd(-1), watchFd(-1),
+    scannerRunning(false), scanRequested(false), scanReady(false), scanEpoch(0) {
+}
+
+LevelIndex::~LevelIndex() {
+    stop();
+
+#ifdef __linux__
+    if (inotifyFd >= 0) {
+        close(inotifyFd);
+    }
+#endif
+}
+
+void LevelIndex::stop() {
+    {
+        std::lock_guard<std::mutex> lock(scanMutex);
+        scannerRunning = false;
+        scanRequested = false;
+    }
+    scanWake.notify_one();
+    if (scanner.joinable()) {
+        scanner.join();
+    }
+}
+
+bool LevelIndex::watchDirectory() {
+#ifdef __linux__
+    if (inotifyFd < 0) {
+        inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyFd < 0) {
+            cerr << "inotify unavailable, falling back to periodic rescans" << endl;
+            return false;
+        }
+    }
+    if (watchFd < 0) {
+        watchFd = inotify_add_watch(inotifyFd, levelsPath.c_str(),
+            IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | IN_MOVE_SELF);
+        // Зміни до появи спостереження подій не дали - потрібен повний скан
+        if (watchFd >= 0) {
+            needsRescan = true;
+        }
+    }
+    return watchFd >= 0;
+#else
+    return false;
+#endif
+}
+
+void LevelIndex::update() {
+    // Спочатку ставимо спостереження, щоб не пропустити зміни під час сканування
+    bool watching = watchDirectory();
+
+    if (!needsRescan && watching) {
+        readEvents();
+    }
+    if (needsRescan) {
+        // Перший скан і явне оновлення - синхронно, щоб список одразу був повним
+        rescan();
+        if (watching) {
+            // Події, що прийшли під час сканування, вже враховані; переповнення
+            // або втрата спостереження знову ставлять needsRescan
+            readEvents();
+        }
+    }
+    else if (!watching) {
+        collectScan();
+        if (SDL_GetTicks() - lastScanTime >= RESCAN_INTERVAL) {
+            requestScan();
+        }
+    }
+}
+
+void LevelIndex::readEvents() {
+#ifdef __linux__
+    alignas(struct inotify_event) char buffer[16 * 1024];
+
+    while (true) {
+        ssize_t length = read(inotifyFd, buffer, sizeof(buffer));
+        if (length <= 0) {
+            break; // EAGAIN - подій більше немає
+        }
+
+        for (char* cursor = buffer; cursor < buffer + length;) {
+            const struct inotify_event* event = reinterpret_cast<const struct inotify_event*>(cursor);
+            cursor += sizeof(struct inotify_event) + event->len;
+
+            if (event->mask & (IN_Q_OVERFLOW | IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                // Черга переповнилась або директорію прибрали - повний перескан
+                if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)) {
+                    watchFd = -1;
+                }
+                needsRescan = true;
+                continue;
+            }
+            if (event->len == 0) continue;
+
+            std::string name = event->name;
+            if (!isLevelFileName(name)) continue;
+
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                addName(name);
+            }
+            else if (event->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                removeName(name);
+            }
+        }
+    }
+#endif
+}
+
+void LevelIndex::addName(const std::string& name) {
+    auto position = std::lower_bound(names.begin(), names.end(), name, utils::naturalLess);
+    if (position != names.end() && *position == name) return;
+
+    names.insert(position, name);
+    version++;
+}
+
+void LevelIndex::removeName(const std::string& name) {
+    auto position = std::lower_bound(names.begin(), names.end(), name, utils::naturalLess);
+    if (position == names.end() || *position != name) return;
+
+    names.erase(position);
+    version++;
+}
+
+std::vector<std::string> LevelIndex::scanDirectory(const std::string& levelsPath) {
+    TRACE_ZONE("LevelIndex::scanDirectory");
+    std::vector<std::string> levelFiles;
+
+    try {
+        // Перевіряємо чи існує директорія
+        if (!fs::exists(levelsPath)) {
+            fs::create_directories(levelsPath);
+            cout << "Created levels directory: " << levelsPath << endl;
+        }
+
+        // Отримуємо список .bin файлів
+        for (const auto& entry : fs::directory_iterator(levelsPath)) {
+            if (entry.path().extension() == ".bin") {
+                levelFiles.push_back(entry.path().filename().string());
+            }
+        }
+    }
+    catch (const fs::filesystem_error& e) {
+        cerr << "Error accessing directory: " << e.what() << endl;
+    }
+
+    // Сортуємо список у природному порядку
+    std::sort(levelFiles.begin(), levelFiles.end(), utils::naturalLess);
+    return levelFiles;
+}
+
+void LevelIndex::applyScan(std::vector<std::string> levelFiles) {
+    if (levelFiles != names) {
+        names.swap(levelFiles);
+        version++;
+        cout << "Total levels found: " << names.size() << endl;
+    }
+}
+
+void LevelIndex::rescan() {
+    lastScanTime = SDL_GetTicks();
+    needsRescan = false;
+
+    // Фоновий скан, розпочатий раніше, не повинен повернути старіший список
+    {
+        std::lock_guard<std::mutex> lock(scanMutex);
+        scanEpoch++;
+        scanReady = false;
+        scannedNames.clear();
+    }
+
+    applyScan(scanDirectory(levelsPath));
+}
+
+void LevelIndex::requestScan() {
+    lastScanTime = SDL_GetTicks();
+
+    {
+        std::lock_guard<std::mutex> lock(scanMutex);
+        scanRequested = true;
+        if (!scannerRunning) {
+            scannerRunning = true;
+            scanner = std::thread(&LevelIndex::scannerLoop, this);
+        }
+    }
+    scanWake.notify_one();
+}
+
+void LevelIndex::collectScan() {
+    std::vector<std::string> levelFiles;
+    {
+        std::lock_guard<std::mutex> lock(scanMutex);
+        if (!scanReady) return;
+        levelFiles.swap(scannedNames);
+        scanReady = false;
+    }
+
+    applyScan(std::move(levelFiles));
+}
+
+void LevelIndex::scannerLoop() {
+    TRACE_THREAD_NAME("level index");
+
+    std::unique_lock<std::mutex> lock(scanMutex);
+    while (true) {
+        scanWake.wait(lock, [this]() { return !scannerRunning || scanRequested; });
+        if (!scannerRunning) return;
+
+        scanRequested = false;
+        Uint64 epoch = scanEpoch;
+
+        // Директорію читаємо без блокування - головний потік тим часом малює
+        lock.unlock();
+        std::vector<std::string> levelFiles = scanDirectory(levelsPath);
+        lock.lock();
+
+        if (epoch == scanEpoch) {
+            scannedNames.swap(levelFiles);
+            scanReady = true;
+        }
+    }
+}
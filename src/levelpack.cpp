@@ -0,0 +1,251 @@
+#include "levelpack.h"
+#include "grid.h"
+#include "level.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+using namespace std;
+
+LevelPack::LevelPack() : base(nullptr), size(0), entries(nullptr), levelCount(0)
+#ifdef _WIN32
+    , fileHandle(nullptr), mappingHandle(nullptr)
+#endif
+{
+}
+
+LevelPack::~LevelPack() {
+    close();
+}
+
+bool LevelPack::open(const std::string& packPath) {
+    close();
+
+    // Відображаємо файл у пам'ять лише для читання
+#ifdef _WIN32
+    HANDLE file = CreateFileA(packPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    base = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!base) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+    fileHandle = file;
+    mappingHandle = mapping;
+    size = (size_t)fileSize.QuadPart;
+#else
+    int fd = ::open(packPath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size == 0) {
+        ::close(fd);
+        return false;
+    }
+    void* mapped = mmap(nullptr, (size_t)fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    base = static_cast<const char*>(mapped);
+    size = (size_t)fileInfo.st_size;
+#endif
+
+    // Перевіряємо заголовок і межі всіх записів індексу
+    const Header* header = reinterpret_cast<const Header*>(base);
+    if (size < sizeof(Header) || std::memcmp(header->magic, "PPAK", 4) != 0 || header->version != PACK_VERSION ||
+        header->indexOffset > size || (size - header->indexOffset) / sizeof(IndexEntry) < header->levelCount) {
+        cerr << "Invalid level pack: " << packPath << endl;
+        close();
+        return false;
+    }
+
+    entries = reinterpret_cast<const IndexEntry*>(base + header->indexOffset);
+    levelCount = (int)header->levelCount;
+    for (int i = 0; i < levelCount; i++) {
+        const IndexEntry& entry = entries[i];
+        size_t tileCount = (size_t)entry.width * entry.height;
+        if (entry.width == 0 || entry.height == 0 || entry.dataOffset > size || size - entry.dataOffset < tileCount) {
+            cerr << "Invalid level pack entry " << i << ": " << packPath << endl;
+            close();
+            return false;
+        }
+
+        // Старт за межами поля або в стіні - та сама перевірка, що й при читанні файлу рівня
+        if (entry.startX < 0 || entry.startY < 0 || entry.startX >= entry.width || entry.startY >= entry.height ||
+            base[entry.dataOffset + (size_t)entry.startY * entry.width + entry.startX] == WALL) {
+            cerr << "Invalid start position " << entry.startX << "," << entry.startY
+                << " in level pack entry " << i << ": " << packPath << endl;
+            close();
+            return false;
+        }
+    }
+
+    cout << "Opened level pack: " << packPath << " (" << levelCount << " levels)" << endl;
+    return true;
+}
+
+void LevelPack::close() {
+    if (!base) return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(base);
+    CloseHandle(static_cast<HANDLE>(mappingHandle));
+    CloseHandle(static_cast<HANDLE>(fileHandle));
+    mappingHandle = nullptr;
+    fileHandle = nullptr;
+#else
+    munmap(const_cast<char*>(base), size);
+#endif
+
+    base = nullptr;
+    size = 0;
+    entries = nullptr;
+    levelCount = 0;
+}
+
+std::string_view LevelPack::getName(int index) const {
+    const char* name = entries[index].name;
+    return std::string_view(name, strnlen(name, sizeof(entries[index].name)));
+}
+
+std::span<const char> LevelPack::getTiles(int index) const {
+    const IndexEntry& entry = entries[index];
+    return { base + entry.dataOffset, (size_t)entry.width * entry.height };
+}
+
+int LevelPack::find(std::string_view name) const {
+    int low = 0, high = levelCount;
+    while (low < high) {
+        int middle = (low + high) / 2;
+        if (getName(middle) < name) {
+            low = middle + 1;
+        }
+        else {
+            high = middle;
+        }
+    }
+    return (low < levelCount && getName(low) == name) ? low : -1;
+}
+
+int LevelPack::findCurrent(std::string_view name, const std::string& filePath) const {
+    int index = find(name);
+    if (index < 0) return -1;
+
+    SDL_PathInfo info;
+    if (!SDL_GetPathInfo(filePath.c_str(), &info) || info.type != SDL_PATHTYPE_FILE) {
+        return index;
+    }
+    const IndexEntry& entry = entries[index];
+    return (info.size == entry.sourceSize && info.modify_time == entry.sourceModifyTime) ? index : -1;
+}
+
+bool LevelPack::build(const std::string& levelsPath, const std::string& packPath) {
+    struct PackedLevel {
+        std::string name;
+        Grid grid;
+        int startX;
+        int startY;
+        SDL_PathInfo info;
+    };
+    std::vector<PackedLevel> levels;
+
+    // Зчитуємо всі рівні директорії
+    try {
+        for (const auto& entry : fs::directory_iterator(levelsPath)) {
+            if (entry.path().extension() != ".bin") continue;
+
+            PackedLevel level;
+            level.name = entry.path().filename().string();
+            if (level.name.size() > MAX_NAME_LENGTH) {
+                cerr << "Level name too long for pack, skipped: " << level.name << endl;
+                continue;
+            }
+            if (!SDL_GetPathInfo(entry.path().string().c_str(), &level.info) ||
+                !Level::readLevelFile(entry.path().string(), level.grid, level.startX, level.startY)) {
+                continue;
+            }
+            levels.push_back(std::move(level));
+        }
+    }
+    catch (const fs::filesystem_error& e) {
+        cerr << "Error accessing directory: " << e.what() << endl;
+        return false;
+    }
+
+    // Індекс відсортований за іменами для двійкового пошуку
+    std::sort(levels.begin(), levels.end(), [](const PackedLevel& a, const PackedLevel& b) {
+        return a.name < b.name;
+    });
+
+    Header header = {};
+    std::memcpy(header.magic, "PPAK", 4);
+    header.version = PACK_VERSION;
+    header.levelCount = (Uint32)levels.size();
+    header.indexOffset = sizeof(Header);
+
+    std::vector<IndexEntry> index(levels.size());
+    size_t dataOffset = sizeof(Header) + levels.size() * sizeof(IndexEntry);
+    for (size_t i = 0; i < levels.size(); i++) {
+        IndexEntry& entry = index[i];
+        std::memset(&entry, 0, sizeof(entry));
+        std::memcpy(entry.name, levels[i].name.data(), levels[i].name.size());
+        entry.dataOffset = (Uint32)dataOffset;
+        entry.width = (Uint16)levels[i].grid.getWidth();
+        entry.height = (Uint16)levels[i].grid.getHeight();
+        entry.startX = levels[i].startX;
+        entry.startY = levels[i].startY;
+        entry.sourceSize = levels[i].info.size;
+        entry.sourceModifyTime = levels[i].info.modify_time;
+        dataOffset += levels[i].grid.data().size();
+    }
+    if (dataOffset > UINT32_MAX) {
+        cerr << "Level pack would exceed 4 GB: " << packPath << endl;
+        return false;
+    }
+
+    std::ofstream outFile(packPath, std::ios::binary | std::ios::out);
+    if (!outFile) {
+        cerr << "Failed to open file for writing: " << packPath << endl;
+        return false;
+    }
+
+    outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    outFile.write(reinterpret_cast<const char*>(index.data()), index.size() * sizeof(IndexEntry));
+    for (const auto& level : levels) {
+        std::span<const char> cells = level.grid.data();
+        outFile.write(cells.data(), cells.size());
+    }
+
+    cout << "Packed " << levels.size() << " levels into " << packPath << endl;
+    return outFile.good();
+}
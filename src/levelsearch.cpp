@@ -0,0 +1,106 @@
+#include "levelsearch.h"
+#include "utils.h"
+#include <cctype>
+#include <cstring>
+#include <numeric>
+
+Uint64 LevelSearch::charBit(char c) {
+    if (c >= 'a' && c <= 'z') return 1ULL << (c - 'a');
+    if (c >= '0' && c <= '9') return 1ULL << (26 + c - '0');
+    return 1ULL << (36 + (unsigned char)c % 28);
+}
+
+void LevelSearch::build(const std::vector<std::string>& names) {
+    text.clear();
+    offsets.clear();
+    charMasks.clear();
+    offsets.reserve(names.size() + 1);
+    charMasks.reserve(names.size());
+
+    for (const auto& name : names) {
+        offsets.push_back((Uint32)text.size());
+
+        Uint64 mask = 0;
+        for (char c : utils::removeFileExtension(name)) {
+            c = (char)std::tolower((unsigned char)c);
+            text.push_back(c);
+            mask |= charBit(c);
+        }
+        charMasks.push_back(mask);
+    }
+    offsets.push_back((Uint32)text.size());
+
+    // Попередні результати відносяться до старого списку
+    lastQuery.clear();
+    candidates.resize(names.size());
+    std::iota(candidates.begin(), candidates.end(), 0);
+    results = candidates;
+}
+
+bool LevelSearch::matchesPrefix(int index, const std::string& query) const {
+    Uint32 length = offsets[index + 1] - offsets[index];
+    return length >= query.size() && std::memcmp(&text[offsets[index]], query.data(), query.size()) == 0;
+}
+
+bool LevelSearch::matchesFuzzy(int index, const std::string& query) const {
+    // Символи запиту мають зустрічатися в назві в тому ж порядку
+    const char* cursor = &text[offsets[index]];
+    const char* end = text.data() + offsets[index + 1];
+    for (char c : query) {
+        const char* found = (const char*)std::memchr(cursor, c, end - cursor);
+        if (!found) return false;
+        cursor = found + 1;
+    }
+    return true;
+}
+
+const std::vector<int>& LevelSearch::search(const std::string& rawQuery) {
+    std::string query;
+    for (char c : rawQuery) {
+        query.push_back((char)std::tolower((unsigned char)c));
+    }
+    if (query == lastQuery) {
+        return results;
+    }
+    std::string previousQuery;
+    previousQuery.swap(lastQuery);
+    lastQuery = query;
+
+    if (query.empty()) {
+        candidates.resize(size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+        results = candidates;
+        return results;
+    }
+
+    // Довший запит може збігтися лише з тим, що збігалося з коротшим
+    if (query.compare(0, previousQuery.size(), previousQuery) != 0) {
+        candidates.resize(size());
+        std::iota(candidates.begin(), candidates.end(), 0);
+    }
+
+    Uint64 queryMask = 0;
+    for (char c : query) {
+        queryMask |= charBit(c);
+    }
+
+    // Один прохід: збіги за префіксом одразу в results, решта - в кінець candidates
+    results.clear();
+    size_t kept = 0;
+    for (int index : candidates) {
+        if ((charMasks[index] & queryMask) != queryMask) continue;
+
+        if (matchesPrefix(index, query)) {
+            results.push_back(index);
+            candidates[kept++] = index;
+        }
+        else if (matchesFuzzy(index, query)) {
+            candidates[kept++] = index;
+            fuzzyMatches.push_back(index);
+        }
+    }
+    candidates.resize(kept);
+    results.insert(results.end(), fuzzyMatches.begin(), fuzzyMatches.end());
+    fuzzyMatches.clear();
+    return results;
+}
@@ -0,0 +1,37 @@
+#include "movelog.h"
+
+MoveLog::MoveLog() : moveCount(0), cursor(0) {
+}
+
+void MoveLog::clear() {
+    words.clear();
+    checkpoints.clear();
+    moveCount = 0;
+    cursor = 0;
+}
+
+void MoveLog::record(int direction, int cellBefore) {
+    // Новий хід після скасування обрізає гілку повтору
+    int index = cursor;
+    moveCount = index + 1;
+    cursor = moveCount;
+
+    words.resize((moveCount + MOVES_PER_WORD - 1) / MOVES_PER_WORD);
+    int shift = (index % MOVES_PER_WORD) * 2;
+    Uint64& word = words[index / MOVES_PER_WORD];
+    word = (word & ~(Uint64(3) << shift)) | (Uint64(direction & 3) << shift);
+
+    checkpoints.resize((moveCount + CHECKPOINT_INTERVAL - 1) / CHECKPOINT_INTERVAL);
+    if (index % CHECKPOINT_INTERVAL == 0) {
+        checkpoints[index / CHECKPOINT_INTERVAL] = cellBefore;
+    }
+}
+
+int MoveLog::getMove(int index) const {
+    int shift = (index % MOVES_PER_WORD) * 2;
+    return static_cast<int>((words[index / MOVES_PER_WORD] >> shift) & 3);
+}
+
+size_t MoveLog::getMemoryUsage() const {
+    return words.capacity() * sizeof(Uint64) + checkpoints.capacity() * sizeof(int);
+}
@@ -0,0 +1,34 @@
+// Конвертер рівнів: збирає всі .bin файли директорії в один пакет,
+// який гра відображає в пам'ять замість читання окремих файлів.
+//
+// Використання: packlevels <levels-directory> [output.pak]
+
+#include "constants.h"
+#include "levelpack.h"
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+namespace fs = std::filesystem;
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: packlevels <levels-directory> [output.pak]" << std::endl;
+        return 1;
+    }
+
+    std::string levelsPath = argv[1];
+    std::string packPath = argc > 2 ? argv[2] : (fs::path(levelsPath) / LEVEL_PACK_FILE).string();
+
+    if (!LevelPack::build(levelsPath, packPath)) {
+        return 1;
+    }
+
+    // Перевіряємо, що пакет відкривається
+    LevelPack pack;
+    if (!pack.open(packPath)) {
+        std::cerr << "Failed to open the written pack: " << packPath << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include "prefetcher.h"
+#include "level.h"
+#include "trace.h"
+
+LevelPrefetcher::LevelPrefetcher() : running(false) {
+}
+
+LevelPrefetcher::~LevelPrefetcher() {
+    stop();
+}
+
+void LevelPrefetcher::start() {
+    if (running) return;
+
+    running = true;
+    worker = std::thread(&LevelPrefetcher::workerLoop, this);
+}
+
+void LevelPrefetcher::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        running = false;
+        pending.clear();
+    }
+    wake.notify_one();
+    worker.join();
+}
+
+void LevelPrefetcher::request(std::vector<std::string> filePaths) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.assign(std::make_move_iterator(filePaths.begin()), std::make_move_iterator(filePaths.end()));
+    }
+    wake.notify_one();
+}
+
+void LevelPrefetcher::collect(LevelCache& cache) {
+    std::vector<Result> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (finished.empty()) return;
+        ready.swap(finished);
+    }
+
+    for (auto& result : ready) {
+        cache.insert(result.filePath, std::move(result.entry));
+    }
+}
+
+void LevelPrefetcher::workerLoop() {
+    TRACE_THREAD_NAME("prefetcher");
+
+    while (true) {
+        std::string filePath;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return !running || !pending.empty(); });
+            if (!running) return;
+
+            filePath = std::move(pending.front());
+            pending.pop_front();
+        }
+
+        // Розбір файлу поза блокуванням
+        TRACE_ZONE("LevelPrefetcher::load");
+        Result result;
+        result.filePath = filePath;
+        if (!LevelCache::statFile(filePath, result.entry.fileSize, result.entry.modifyTime) ||
+            !Level::readLevelFile(filePath, result.entry.grid, result.entry.startX, result.entry.startY)) {
+            continue;
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.push_back(std::move(result));
+    }
+}
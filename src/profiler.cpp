@@ -0,0 +1,213 @@
+#include "profiler.h"
+#include "constants.h"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+
+using namespace std;
+
+namespace {
+    std::atomic<Uint64> allocationCount{ 0 };
+    Uint64 texturesCreated = 0;
+    Uint64 texturesDestroyed = 0;
+}
+
+// Глобальний operator new рахує виділення; масивні і nothrow-варіанти
+// за замовчуванням викликають саме його
+void* operator new(std::size_t size) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (size == 0) size = 1;
+
+    while (true) {
+        void* memory = std::malloc(size);
+        if (memory) return memory;
+
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+namespace profiler {
+    void countTextureCreated() { texturesCreated++; }
+    void countTextureDestroyed() { texturesDestroyed++; }
+    Uint64 getTexturesCreated() { return texturesCreated; }
+    Uint64 getTexturesDestroyed() { return texturesDestroyed; }
+    Uint64 getAllocations() { return allocationCount.load(std::memory_order_relaxed); }
+}
+
+const char* const FrameProfiler::PHASE_NAMES[PHASE_COUNT] = { "events", "animations", "draw", "present" };
+
+FrameProfiler::FrameProfiler() :
+    current{}, phaseStart(0),
+    startDrawCalls(0), startTexturesCreated(0), startTexturesDestroyed(0), startAllocations(0),
+    window(WINDOW_FRAMES), windowHead(0), windowCount(0), histograms{}, windowSums{},
+    logHead(0), frameCount(0),
+    overlayVisible(false), overlayUsed(false), lastOverlayTime(0) {
+    // Журнал виділяється одразу, щоб не спотворювати лічильник виділень під час гри
+    log.reserve(LOG_FRAMES);
+}
+
+int FrameProfiler::bucketOf(Uint64 nanoseconds) {
+    Uint64 microseconds = nanoseconds / 1000;
+    if (microseconds < 16) return (int)microseconds;
+
+    // Старший біт задає октаву, два наступні - чверть октави
+    int octave = std::bit_width(microseconds) - 1;
+    int quarter = (int)((microseconds >> (octave - 2)) & 3);
+    return std::min(16 + (octave - 4) * 4 + quarter, BUCKET_COUNT - 1);
+}
+
+double FrameProfiler::bucketMilliseconds(int bucket) {
+    if (bucket < 16) return (bucket + 0.5) / 1000.0;
+
+    int octave = 4 + (bucket - 16) / 4;
+    int quarter = (bucket - 16) % 4;
+    double width = (double)(1ULL << (octave - 2));
+    double lower = (4 + quarter) * width;
+    return (lower + width / 2) / 1000.0;
+}
+
+void FrameProfiler::beginFrame(Uint64 drawCalls) {
+    current = {};
+    startDrawCalls = drawCalls;
+    startTexturesCreated = texturesCreated;
+    startTexturesDestroyed = texturesDestroyed;
+    startAllocations = profiler::getAllocations();
+    phaseStart = SDL_GetTicksNS();
+}
+
+void FrameProfiler::beginPhase() {
+    phaseStart = SDL_GetTicksNS();
+}
+
+void FrameProfiler::endPhase(Phase phase) {
+    Uint64 now = SDL_GetTicksNS();
+    current.phaseTime[phase] += now - phaseStart;
+    phaseStart = now;
+}
+
+void FrameProfiler::endFrame(Uint64 drawCalls, int trailLength, bool presented) {
+    current.drawCalls = (Uint32)(drawCalls - startDrawCalls);
+    current.texturesCreated = (Uint32)(texturesCreated - startTexturesCreated);
+    current.texturesDestroyed = (Uint32)(texturesDestroyed - startTexturesDestroyed);
+    current.allocations = (Uint32)(profiler::getAllocations() - startAllocations);
+    current.trailLength = (Uint32)trailLength;
+    current.presented = presented;
+
+    if (log.size() < (size_t)LOG_FRAMES) {
+        log.push_back(current);
+    }
+    else {
+        log[logHead] = current;
+        logHead = (logHead + 1) % LOG_FRAMES;
+    }
+    frameCount++;
+
+    // У вікно потрапляють лише намальовані кадри - пропущені не мають часу малювання
+    if (!presented) return;
+
+    std::array<Uint64, PHASE_COUNT>& slot = window[windowHead];
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        if (windowCount == WINDOW_FRAMES) {
+            histograms[phase][bucketOf(slot[phase])]--;
+            windowSums[phase] -= slot[phase];
+        }
+        slot[phase] = current.phaseTime[phase];
+        histograms[phase][bucketOf(slot[phase])]++;
+        windowSums[phase] += slot[phase];
+    }
+    windowHead = (windowHead + 1) % WINDOW_FRAMES;
+    windowCount = std::min(windowCount + 1, WINDOW_FRAMES);
+}
+
+const FrameProfiler::Frame& FrameProfiler::getLastFrame() const {
+    if (log.empty()) return current;
+    if (log.size() < (size_t)LOG_FRAMES) return log.back();
+    return log[(logHead + LOG_FRAMES - 1) % LOG_FRAMES];
+}
+
+FrameProfiler::PhaseStats FrameProfiler::getPhaseStats(Phase phase) const {
+    PhaseStats stats = { 0.0, 0.0, 0.0, 0.0 };
+    if (windowCount == 0) return stats;
+
+    stats.average = windowSums[phase] / 1e6 / windowCount;
+
+    // Перцентилі - з гістограми (точність чверть октави), максимум - точний
+    int medianRank = (windowCount + 1) / 2;
+    int p95Rank = (windowCount * 95 + 99) / 100;
+    int seen = 0;
+    for (int bucket = 0; bucket < BUCKET_COUNT; bucket++) {
+        int before = seen;
+        seen += histograms[phase][bucket];
+        if (before < medianRank && seen >= medianRank) stats.median = bucketMilliseconds(bucket);
+        if (before < p95Rank && seen >= p95Rank) {
+            stats.p95 = bucketMilliseconds(bucket);
+            break;
+        }
+    }
+
+    Uint64 longest = 0;
+    for (int i = 0; i < windowCount; i++) {
+        longest = std::max(longest, window[i][phase]);
+    }
+    stats.max = longest / 1e6;
+
+    // Середина кошика може перевищити справжній максимум
+    stats.median = std::min(stats.median, stats.max);
+    stats.p95 = std::min(stats.p95, stats.max);
+    return stats;
+}
+
+void FrameProfiler::toggleOverlay() {
+    overlayVisible = !overlayVisible;
+    overlayUsed = true;
+    lastOverlayTime = 0;
+    cout << "Frame profiler toggled: " << (overlayVisible ? "ON" : "OFF") << endl;
+}
+
+bool FrameProfiler::isOverlayDue(Uint64 now) const {
+    return overlayVisible && now - lastOverlayTime >= (Uint64)PROFILER_OVERLAY_INTERVAL * SDL_NS_PER_MS;
+}
+
+bool FrameProfiler::saveCsv(const std::string& path) const {
+    std::ofstream file(path);
+    if (!file) {
+        cerr << "Failed to write frame profile: " << path << endl;
+        return false;
+    }
+
+    file << "frame";
+    for (int phase = 0; phase < PHASE_COUNT; phase++) {
+        file << "," << PHASE_NAMES[phase] << "_ms";
+    }
+    file << ",presented,draw_calls,textures_created,textures_destroyed,trail_length,allocations\n";
+
+    // Від найстарішого збереженого кадру
+    size_t count = log.size();
+    size_t first = count < (size_t)LOG_FRAMES ? 0 : (size_t)logHead;
+    for (size_t i = 0; i < count; i++) {
+        const Frame& frame = log[(first + i) % count];
+        file << frameCount - count + i;
+        for (int phase = 0; phase < PHASE_COUNT; phase++) {
+            file << "," << frame.phaseTime[phase] / 1e6;
+        }
+        file << "," << (frame.presented ? 1 : 0) << "," << frame.drawCalls << "," << frame.texturesCreated
+            << "," << frame.texturesDestroyed << "," << frame.trailLength << "," << frame.allocations << "\n";
+    }
+
+    cout << "Frame profile saved: " << count << " frames to " << path << endl;
+    return (bool)file;
+}
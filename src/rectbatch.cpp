@@ -0,0 +1,54 @@
+#include "rectbatch.h"
+#include <vector>
+
+RectBatch::RectBatch() : lastBucket(-1), drawCalls(0), rectCount(0) {
+}
+
+Uint32 RectBatch::packColor(SDL_Color color) {
+    return ((Uint32)color.r << 24) | ((Uint32)color.g << 16) | ((Uint32)color.b << 8) | color.a;
+}
+
+std::vector<SDL_FRect>& RectBatch::bucketFor(SDL_Color color, bool outline) {
+    Uint32 packed = packColor(color);
+
+    // Сусідні клітинки часто одного кольору
+    if (lastBucket >= 0 && buckets[lastBucket].color == packed && buckets[lastBucket].outline == outline) {
+        return buckets[lastBucket].rects;
+    }
+
+    for (int i = 0; i < (int)buckets.size(); i++) {
+        if (buckets[i].color == packed && buckets[i].outline == outline) {
+            lastBucket = i;
+            return buckets[i].rects;
+        }
+    }
+
+    buckets.push_back({ packed, outline, {} });
+    lastBucket = (int)buckets.size() - 1;
+    return buckets.back().rects;
+}
+
+void RectBatch::flush(SDL_Renderer* renderer) {
+    // Кольори, не використані з минулого скидання (наприклад, старі відтінки сліду), прибираємо
+    std::erase_if(buckets, [](const Bucket& bucket) { return bucket.rects.empty(); });
+    lastBucket = -1;
+
+    for (bool outline : { false, true }) {
+        for (auto& bucket : buckets) {
+            if (bucket.outline != outline || bucket.rects.empty()) continue;
+
+            SDL_SetRenderDrawColor(renderer, (Uint8)(bucket.color >> 24), (Uint8)(bucket.color >> 16),
+                (Uint8)(bucket.color >> 8), (Uint8)bucket.color);
+            if (outline) {
+                SDL_RenderRects(renderer, bucket.rects.data(), (int)bucket.rects.size());
+            }
+            else {
+                SDL_RenderFillRects(renderer, bucket.rects.data(), (int)bucket.rects.size());
+            }
+
+            drawCalls++;
+            rectCount += bucket.rects.size();
+            bucket.rects.clear(); // Пам'ять лишається для наступного кадру
+        }
+    }
+}
@@ -1,6 +1,8 @@
 #include "renderer.h"
 #include "constants.h"
+#include "profiler.h"
 #include "utils.h"
+#include "trace.h"
 #include <iostream>
 #include <cmath>
 
@@ -9,7 +11,8 @@ using namespace std;
 Renderer::Renderer() : window(nullptr), renderer(nullptr),
 titleFont(nullptr), menuFont(nullptr),
 smallFont(nullptr), gameFont(nullptr),
-isFullscreen(false), cellSize(0), offsetX(0), offsetY(0) {
+isFullscreen(false), showDoomedOverlay(false), showHint(false), cellSize(0), offsetX(0), offsetY(0),
+boardTexture(nullptr), boardDirty(true), revealedRings(0), revealedAttempt(0), drawCalls(0), textCache(TEXT_CACHE_MEMORY_LIMIT), textEngine(nullptr) {
     // Ініціалізація кольорів
     wallColor = { 150, 150, 150, 255 };       // Колір стін - сірий
     emptyColor = { 244, 244, 240, 255 };      // Колір порожніх клітин - білий
@@ -20,6 +23,7 @@ isFullscreen(false), cellSize(0), offsetX(0), offsetY(0) {
     menuBgColor = { 244, 244, 240, 255 };     // Колір фону меню - такий як порожні клітини
     menuItemColor = { 255, 255, 255, 255 };   // Колір пунктів меню - ідеально білий
     selectedTextColor = { 0, 0, 0, 255 };     // Колір тексту вибраного пункту - ідеально чорний
+    doomedColor = { 60, 60, 60, 110 };        // Затемнення глухих кутів - напівпрозорий темно-сірий
 }
 
 Renderer::~Renderer() {
@@ -43,6 +47,12 @@ bool Renderer::initialize(const std::string& fontPath) {
         return false;
     }
 
+    // Вертикальна синхронізація: презентація чекає на оновлення дисплея
+    if (!SDL_SetRenderVSync(renderer, 1)) {
+        cerr << "Failed to enable VSync: " << SDL_GetError() << endl;
+        // Продовжуємо: частоту кадрів обмежить головний цикл
+    }
+
     cout << "Loading fonts from: " << fontPath << endl;
 
     // Завантаження шрифтів різних розмірів
@@ -67,13 +77,45 @@ bool Renderer::initialize(const std::string& fontPath) {
 
     gameFont = menuFont; // Використовуємо меню шрифт як основний для гри
 
+    // Рушій тексту з атласом гліфів для динамічних рядків
+    textEngine = TTF_CreateRendererTextEngine(renderer);
+    if (!textEngine) {
+        cerr << "Failed to create text engine: " << SDL_GetError() << endl;
+        // Продовжуємо: динамічний текст малюватиметься через кеш текстур
+    }
+
     cout << "Renderer initialized successfully" << endl;
     return true;
 }
 
+bool Renderer::isVSyncEnabled() const {
+    int vsync = 0;
+    return renderer && SDL_GetRenderVSync(renderer, &vsync) && vsync != 0;
+}
+
+float Renderer::getRefreshRate() const {
+    if (!window) return 0.0f;
+    const SDL_DisplayMode* mode = SDL_GetCurrentDisplayMode(SDL_GetDisplayForWindow(window));
+    return mode ? mode->refresh_rate : 0.0f;
+}
+
 void Renderer::cleanup() {
     cout << "Cleaning up renderer resources..." << endl;
 
+    // Текстури тексту прив'язані до шрифтів і рендерера, які зараз закриваються
+    textCache.clear();
+    for (auto& [font, text] : dynamicTexts) {
+        TTF_DestroyText(text);
+    }
+    dynamicTexts.clear();
+    if (textEngine) TTF_DestroyRendererTextEngine(textEngine);
+    textEngine = nullptr;
+    if (boardTexture) {
+        SDL_DestroyTexture(boardTexture);
+        profiler::countTextureDestroyed();
+    }
+    boardTexture = nullptr;
+
     if (titleFont) TTF_CloseFont(titleFont);
     if (menuFont) TTF_CloseFont(menuFont);
     if (smallFont) TTF_CloseFont(smallFont);
@@ -108,12 +150,64 @@ SDL_Texture* Renderer::createTextTexture(const std::string& text, SDL_Color colo
     if (!texture) {
         cerr << "Failed to create texture from text: " << SDL_GetError() << endl;
     }
+    else {
+        profiler::countTextureCreated();
+    }
 
     return texture;
 }
 
+SDL_Texture* Renderer::getTextTexture(const std::string& text, SDL_Color color, TTF_Font* font) {
+    // Статичні рядки меню і підказок растеризуються лише один раз
+    SDL_Texture* texture = textCache.find(text, font, color);
+    if (!texture) {
+        texture = createTextTexture(text, color, font);
+        if (texture) {
+            textCache.insert(text, font, color, texture);
+        }
+    }
+    return texture;
+}
+
+TTF_Text* Renderer::prepareDynamicText(std::string_view text, SDL_Color color, TTF_Font* font) {
+    if (!textEngine || !font) return nullptr;
+
+    // Один об'єкт на шрифт: новий рядок лише перекладає гліфи з атласу
+    TTF_Text*& dynamicText = dynamicTexts[font];
+    if (!dynamicText) {
+        dynamicText = TTF_CreateText(textEngine, font, text.data(), text.length());
+        if (!dynamicText) {
+            cerr << "Failed to create text: " << SDL_GetError() << endl;
+            dynamicTexts.erase(font);
+            return nullptr;
+        }
+    }
+    else {
+        TTF_SetTextString(dynamicText, text.data(), text.length());
+    }
+
+    TTF_SetTextColor(dynamicText, color.r, color.g, color.b, color.a);
+    return dynamicText;
+}
+
+void Renderer::renderDynamicText(std::string_view text, int x, int y, SDL_Color color, TTF_Font* font) {
+    TTF_Text* dynamicText = prepareDynamicText(text, color, font);
+    if (!dynamicText) {
+        renderText(std::string(text), x, y, color, font);
+        return;
+    }
+    TTF_DrawRendererText(dynamicText, (float)x, (float)y);
+    drawCalls++;
+}
+
+void Renderer::handleRenderReset() {
+    // Вміст текстур втрачено разом з пристроєм - растеризуємо текст і поле заново
+    textCache.clear();
+    boardDirty = true;
+}
+
 void Renderer::renderText(const std::string& text, int x, int y, SDL_Color color, TTF_Font* font) {
-    SDL_Texture* textTexture = createTextTexture(text, color, font);
+    SDL_Texture* textTexture = getTextTexture(text, color, font);
     if (!textTexture) return;
 
     // Отримуємо розмір текстури
@@ -130,9 +224,7 @@ void Renderer::renderText(const std::string& text, int x, int y, SDL_Color color
 
     // Відображаємо текст
     SDL_RenderTexture(renderer, textTexture, NULL, &destRect);
-
-    // Звільняємо ресурси
-    SDL_DestroyTexture(textTexture);
+    drawCalls++;
 }
 
 void Renderer::calculateScaling(int levelWidth, int levelHeight) {
@@ -152,6 +244,9 @@ void Renderer::calculateScaling(int levelWidth, int levelHeight) {
     offsetX = (windowWidth - totalWidth) / 2;
     offsetY = (windowHeight - (float)GAME_FIELD_HEIGHT) / 2;
 
+    // Новий рівень або розмір вікна - поле треба перемалювати
+    boardDirty = true;
+
     cout << "Recalculated scaling: cell size = " << cellSize
         << ", offset = (" << offsetX << ", " << offsetY << ")" << endl;
 }
@@ -162,10 +257,22 @@ void Renderer::toggleFullscreen() {
     cout << "Fullscreen toggled: " << (isFullscreen ? "ON" : "OFF") << endl;
 }
 
+void Renderer::toggleDoomedOverlay() {
+    showDoomedOverlay = !showDoomedOverlay;
+    cout << "Dead end overlay toggled: " << (showDoomedOverlay ? "ON" : "OFF") << endl;
+}
+
+void Renderer::toggleHint() {
+    showHint = !showHint;
+    cout << "Hint toggled: " << (showHint ? "ON" : "OFF") << endl;
+}
+
 void Renderer::drawMainMenu(int selectedMenuItem, const std::string menuItems[]) {
+    TRACE_ZONE("Renderer::drawMainMenu");
     // Використовуємо світло-сірий колір для фону меню
     SDL_SetRenderDrawColor(renderer, menuBgColor.r, menuBgColor.g, menuBgColor.b, menuBgColor.a);
     SDL_RenderClear(renderer);
+    drawCalls++;
 
     // Отримуємо розміри вікна
     int windowWidth, windowHeight;
@@ -175,7 +282,7 @@ void Renderer::drawMainMenu(int selectedMenuItem, const std::string menuItems[])
     int titleY = 100; // Відстань від верху: 100 пікселів
 
     // Відтворюємо заголовок (центрований)
-    SDL_Texture* titleTexture = createTextTexture("Push-Push", { 0, 0, 0, 255 }, titleFont);
+    SDL_Texture* titleTexture = getTextTexture("Push-Push", { 0, 0, 0, 255 }, titleFont);
     if (titleTexture) {
         float titleWidth, titleHeight;
         SDL_GetTextureSize(titleTexture, &titleWidth, &titleHeight);
@@ -186,7 +293,7 @@ void Renderer::drawMainMenu(int selectedMenuItem, const std::string menuItems[])
             titleHeight
         };
         SDL_RenderTexture(renderer, titleTexture, NULL, &titleRect);
-        SDL_DestroyTexture(titleTexture);
+        drawCalls++;
     }
 
     // Початкова позиція пунктів меню
@@ -214,6 +321,7 @@ void Renderer::drawMainMenu(int selectedMenuItem, const std::string menuItems[])
         // Малюємо білий фон для всіх кнопок
         SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
         SDL_RenderFillRect(renderer, &itemRect);
+        drawCalls++;
 
         // Визначаємо колір тексту залежно від того, вибраний пункт чи ні
         SDL_Color textColor;
@@ -226,7 +334,7 @@ void Renderer::drawMainMenu(int selectedMenuItem, const std::string menuItems[])
         }
 
         // Створюємо текстуру для тексту пункту меню
-        SDL_Texture* itemTexture = createTextTexture(menuItems[i], textColor, menuFont);
+        SDL_Texture* itemTexture = getTextTexture(menuItems[i], textColor, menuFont);
         if (itemTexture) {
             float textWidth, textHeight;
             SDL_GetTextureSize(itemTexture, &textWidth, &textHeight);
@@ -240,7 +348,7 @@ void Renderer::drawMainMenu(int selectedMenuItem, const std::string menuItems[])
             };
 
             SDL_RenderTexture(renderer, itemTexture, NULL, &textRect);
-            SDL_DestroyTexture(itemTexture);
+            drawCalls++;
         }
     }
 
@@ -250,7 +358,7 @@ void Renderer::drawMainMenu(int selectedMenuItem, const std::string menuItems[])
     // Відтворюємо пояснювальний напис - тільки "Term project"
     std::string creditsText = "Term project";
 
-    SDL_Texture* creditsTexture = createTextTexture(creditsText, { 150, 150, 150, 255 }, smallFont);
+    SDL_Texture* creditsTexture = getTextTexture(creditsText, { 150, 150, 150, 255 }, smallFont);
     if (creditsTexture) {
         float textWidth, textHeight;
         SDL_GetTextureSize(creditsTexture, &textWidth, &textHeight);
@@ -263,16 +371,17 @@ void Renderer::drawMainMenu(int selectedMenuItem, const std::string menuItems[])
         };
 
         SDL_RenderTexture(renderer, creditsTexture, NULL, &textRect);
-        SDL_DestroyTexture(creditsTexture);
+        drawCalls++;
     }
-
-    SDL_RenderPresent(renderer);
 }
 
-void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int selectedLevelIndex, int firstVisibleLevel) {
+void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, const std::vector<int>& levelView,
+    int selectedLevelIndex, int firstVisibleLevel, const std::string& searchQuery, LevelThumbnails& thumbnails) {
+    TRACE_ZONE("Renderer::drawLevelSelect");
     // Використовуємо світло-сірий колір для фону меню
     SDL_SetRenderDrawColor(renderer, menuBgColor.r, menuBgColor.g, menuBgColor.b, menuBgColor.a);
     SDL_RenderClear(renderer);
+    drawCalls++;
 
     // Отримуємо розміри вікна
     int windowWidth, windowHeight;
@@ -282,7 +391,7 @@ void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int s
     int titleY = 100; // Така ж відстань як і в головному меню
 
     // Відтворюємо заголовок (центрований)
-    SDL_Texture* titleTexture = createTextTexture("Select Level", { 0, 0, 0, 255 }, titleFont);
+    SDL_Texture* titleTexture = getTextTexture("Select Level", { 0, 0, 0, 255 }, titleFont);
     if (titleTexture) {
         float titleWidth, titleHeight;
         SDL_GetTextureSize(titleTexture, &titleWidth, &titleHeight);
@@ -293,7 +402,27 @@ void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int s
             titleHeight
         };
         SDL_RenderTexture(renderer, titleTexture, NULL, &titleRect);
-        SDL_DestroyTexture(titleTexture);
+        drawCalls++;
+    }
+
+    // Рядок пошуку та позиція у списку між заголовком і списком
+    std::string searchText = searchQuery.empty() ? "Type to search" : "Search: " + searchQuery;
+    if (!levelView.empty()) {
+        searchText += "   (" + std::to_string(selectedLevelIndex + 1) + " / " + std::to_string(levelView.size()) + ")";
+    }
+    SDL_Color searchColor = { 100, 100, 100, 255 };
+    TTF_Text* searchLine = prepareDynamicText(searchText, searchColor, smallFont);
+    if (searchLine) {
+        int textWidth, textHeight;
+        TTF_GetTextSize(searchLine, &textWidth, &textHeight);
+        TTF_DrawRendererText(searchLine, (windowWidth - textWidth) / 2.0f, (float)(titleY + 75));
+        drawCalls++;
+    }
+    else {
+        // Без рушія тексту - через кеш текстур, як у renderDynamicText
+        int textWidth = 0, textHeight = 0;
+        TTF_GetStringSize(smallFont, searchText.c_str(), searchText.length(), &textWidth, &textHeight);
+        renderText(searchText, (windowWidth - textWidth) / 2, titleY + 75, searchColor, smallFont);
     }
 
     // Початкова позиція списку рівнів
@@ -302,8 +431,8 @@ void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int s
     int levelItemPadding = 20; // Той же відступ
     int levelWidth = 500; // Та ж ширина
 
-    // Якщо немає рівнів
-    if (levelFiles.empty()) {
+    // Якщо немає рівнів (або жоден не підходить під пошук)
+    if (levelView.empty()) {
         // Обчислюємо позицію для центрування
         int noLevelX = (windowWidth - levelWidth) / 2;
         int noLevelY = levelStartY;
@@ -318,9 +447,11 @@ void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int s
         // Малюємо білу кнопку
         SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
         SDL_RenderFillRect(renderer, &noLevelsRect);
+        drawCalls++;
 
         // Створюємо текст "No levels found"
-        SDL_Texture* noLevelsTexture = createTextTexture("No levels found", { 150, 150, 150, 255 }, menuFont);
+        SDL_Texture* noLevelsTexture = getTextTexture(levelFiles.empty() ? "No levels found" : "No matches",
+            { 150, 150, 150, 255 }, menuFont);
         if (noLevelsTexture) {
             float textWidth, textHeight;
             SDL_GetTextureSize(noLevelsTexture, &textWidth, &textHeight);
@@ -334,12 +465,12 @@ void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int s
             };
 
             SDL_RenderTexture(renderer, noLevelsTexture, NULL, &textRect);
-            SDL_DestroyTexture(noLevelsTexture);
+            drawCalls++;
         }
     }
-    // Відображаємо список рівнів
+    // Відображаємо лише видиму частину списку
     else {
-        int visibleCount = min(MAX_VISIBLE_LEVELS, (int)levelFiles.size() - firstVisibleLevel);
+        int visibleCount = min(MAX_VISIBLE_LEVELS, (int)levelView.size() - firstVisibleLevel);
 
         for (int i = 0; i < visibleCount; i++) {
             int levelIndex = firstVisibleLevel + i;
@@ -358,9 +489,25 @@ void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int s
             // Малюємо білий фон для всіх кнопок
             SDL_SetRenderDrawColor(renderer, 255, 255, 255, 255);
             SDL_RenderFillRect(renderer, &itemRect);
+            drawCalls++;
+
+            // Мініатюра ліворуч у кнопці, якщо вона вже готова
+            const std::string& fileName = levelFiles[levelView[levelIndex]];
+            SDL_FRect thumbnailSource;
+            if (thumbnails.find(fileName, thumbnailSource)) {
+                float thumbnailMargin = (levelItemHeight - LevelThumbnails::THUMBNAIL_SIZE) / 2.0f;
+                SDL_FRect thumbnailRect = {
+                    itemRect.x + thumbnailMargin,
+                    itemRect.y + thumbnailMargin,
+                    (float)LevelThumbnails::THUMBNAIL_SIZE,
+                    (float)LevelThumbnails::THUMBNAIL_SIZE
+                };
+                SDL_RenderTexture(renderer, thumbnails.getAtlas(), &thumbnailSource, &thumbnailRect);
+                drawCalls++;
+            }
 
             // Прибираємо розширення .bin з назви рівня
-            std::string levelName = utils::removeFileExtension(levelFiles[levelIndex]);
+            std::string levelName = utils::removeFileExtension(fileName);
 
             // Визначаємо колір тексту
             SDL_Color textColor;
@@ -372,7 +519,7 @@ void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int s
             }
 
             // Створюємо текстуру для назви рівня
-            SDL_Texture* levelTexture = createTextTexture(levelName, textColor, menuFont);
+            SDL_Texture* levelTexture = getTextTexture(levelName, textColor, menuFont);
             if (levelTexture) {
                 float textWidth, textHeight;
                 SDL_GetTextureSize(levelTexture, &textWidth, &textHeight);
@@ -386,18 +533,18 @@ void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int s
                 };
 
                 SDL_RenderTexture(renderer, levelTexture, NULL, &textRect);
-                SDL_DestroyTexture(levelTexture);
+                drawCalls++;
             }
         }
     }
 
     // Позиція для інструкцій
-    int instructionsY = levelStartY + min(MAX_VISIBLE_LEVELS, (int)levelFiles.size() == 0 ? 1 : (int)levelFiles.size()) * (levelItemHeight + levelItemPadding) + 60;
+    int instructionsY = levelStartY + min(MAX_VISIBLE_LEVELS, (int)levelView.size() == 0 ? 1 : (int)levelView.size()) * (levelItemHeight + levelItemPadding) + 60;
 
     // Додаємо інструкції внизу
-    std::string instructionsText = "Press ESC to return to menu";
+    std::string instructionsText = "PgUp/PgDn - Page   Home/End - Jump   Backspace - Edit search   ESC - Back";
 
-    SDL_Texture* instructTexture = createTextTexture(instructionsText, { 150, 150, 150, 255 }, smallFont);
+    SDL_Texture* instructTexture = getTextTexture(instructionsText, { 150, 150, 150, 255 }, smallFont);
     if (instructTexture) {
         float textWidth, textHeight;
         SDL_GetTextureSize(instructTexture, &textWidth, &textHeight);
@@ -410,260 +557,205 @@ void Renderer::drawLevelSelect(const std::vector<std::string>& levelFiles, int s
         };
 
         SDL_RenderTexture(renderer, instructTexture, NULL, &textRect);
-        SDL_DestroyTexture(instructTexture);
+        drawCalls++;
     }
-
-    SDL_RenderPresent(renderer);
 }
 
-void Renderer::drawTrail(const std::vector<Level::TrailPoint>& trail, Uint32 currentTime) {
-    // Малюємо слід гравця
-    for (const auto& point : trail) {
-        SDL_FRect cellRect;
-        cellRect.x = offsetX + point.x * cellSize;
-        cellRect.y = offsetY + point.y * cellSize;
-        cellRect.w = cellSize;
-        cellRect.h = cellSize;
-
-        // Розраховуємо прозорість на основі часу існування сліду
-        float lifetime = (float)(currentTime - point.timeCreated) / TRAIL_LIFETIME;
-        Uint8 alpha = static_cast<Uint8>(255 * (1.0f - lifetime));
+bool Renderer::buildBoardLayer(const Level& level) {
+    TRACE_ZONE("Renderer::buildBoardLayer");
+    int boardWidth = (int)ceilf(cellSize * level.getWidth());
+    int boardHeight = (int)ceilf(cellSize * level.getHeight());
 
-        // Малюємо слід світло-жовтого кольору з прозорістю
-        SDL_SetRenderDrawColor(renderer, startColor.r, startColor.g, startColor.b, alpha);
-        SDL_RenderFillRect(renderer, &cellRect);
+    // Текстуру створюємо заново лише при зміні розміру
+    float textureWidth = 0, textureHeight = 0;
+    if (boardTexture) {
+        SDL_GetTextureSize(boardTexture, &textureWidth, &textureHeight);
+    }
+    if (!boardTexture || (int)textureWidth != boardWidth || (int)textureHeight != boardHeight) {
+        if (boardTexture) {
+            SDL_DestroyTexture(boardTexture);
+            profiler::countTextureDestroyed();
+        }
+        boardTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, boardWidth, boardHeight);
+        if (!boardTexture) {
+            cerr << "Failed to create board texture: " << SDL_GetError() << endl;
+            return false;
+        }
+        profiler::countTextureCreated();
+        SDL_SetTextureScaleMode(boardTexture, SDL_SCALEMODE_NEAREST);
     }
-}
 
-void Renderer::drawLevelWin(const Level& level) {
-    // Фон - такий же як для звичайного рівня
+    SDL_SetRenderTarget(renderer, boardTexture);
     SDL_SetRenderDrawColor(renderer, emptyColor.r, emptyColor.g, emptyColor.b, emptyColor.a);
     SDL_RenderClear(renderer);
+    drawCalls++;
 
-    // Отримуємо розміри вікна
-    int windowWidth, windowHeight;
-    SDL_GetWindowSize(window, &windowWidth, &windowHeight);
-
-    // Малюємо рівень з анімацією "заливки" синім кольором
+    // Порожні клітинки вже залиті фоном
     for (int i = 0; i < level.getHeight(); i++) {
         for (int j = 0; j < level.getWidth(); j++) {
-            SDL_FRect cellRect;
-            cellRect.x = offsetX + j * cellSize;
-            cellRect.y = offsetY + i * cellSize;
-            cellRect.w = cellSize;
-            cellRect.h = cellSize;
-
-            // Рахуємо відстань від клітинки до фінішу (де стоїть гравець)
-            int distX = j - level.getPlayerX();
-            int distY = i - level.getPlayerY();
-            int distance = static_cast<int>(sqrt(distX * distX + distY * distY));
-
-            if (distance <= level.getAnimationRadius()) {
-                // Клітинки всередині радіусу анімації стають синіми
-                if (level.getTileAt(j, i) == WALL) {
-                    // Стіни - темно-сині
-                    SDL_SetRenderDrawColor(renderer, 0, 0, 150, 255);
-                }
-                else {
-                    // Шлях - світло-синій
-                    SDL_SetRenderDrawColor(renderer, 100, 150, 255, 255);
-                }
-            }
-            else {
-                // Інші клітинки звичайні
-                if (i == level.getPlayerY() && j == level.getPlayerX()) {
-                    // Гравець
-                    SDL_SetRenderDrawColor(renderer, playerColor.r, playerColor.g, playerColor.b, playerColor.a);
-                }
-                else {
-                    char tile = level.getTileAt(j, i);
-                    switch (tile) {
-                    case WALL:
-                        SDL_SetRenderDrawColor(renderer, wallColor.r, wallColor.g, wallColor.b, wallColor.a);
-                        break;
-                    case EMPTY:
-                        SDL_SetRenderDrawColor(renderer, emptyColor.r, emptyColor.g, emptyColor.b, emptyColor.a);
-                        break;
-                    case TRAP:
-                        SDL_SetRenderDrawColor(renderer, trapColor.r, trapColor.g, trapColor.b, trapColor.a);
-                        break;
-                    case FINISH:
-                        SDL_SetRenderDrawColor(renderer, finishColor.r, finishColor.g, finishColor.b, finishColor.a);
-                        break;
-                    case START:
-                        SDL_SetRenderDrawColor(renderer, startColor.r, startColor.g, startColor.b, startColor.a);
-                        break;
-                    default:
-                        SDL_SetRenderDrawColor(renderer, emptyColor.r, emptyColor.g, emptyColor.b, emptyColor.a);
-                    }
-                }
+            SDL_Color color;
+            switch (level.getTileAt(j, i)) {
+            case WALL: color = wallColor; break;
+            case TRAP: color = trapColor; break;
+            case FINISH: color = finishColor; break;
+            case START: color = startColor; break;
+            default: continue;
             }
 
-            SDL_RenderFillRect(renderer, &cellRect);
+            SDL_FRect cellRect = { j * cellSize, i * cellSize, cellSize, cellSize };
+            cellBatch.addFill(color, cellRect);
         }
     }
+    cellBatch.flush(renderer);
 
-    // Текст перемоги
-    std::string winText = "You Win!";
-    renderText(winText, (windowWidth - 200) / 2, offsetY - 40, finishColor, menuFont);
+    SDL_SetRenderTarget(renderer, NULL);
+    boardDirty = false;
+    revealedRings = 0;
+    return true;
+}
 
-    // Інструкції
-    renderText("R - Restart   ESC - Menu   F - Fullscreen", 20, WINDOW_HEIGHT - 40, wallColor, smallFont);
+void Renderer::drawTrail(const Trail& trail, Uint32 currentTime) {
+    TRACE_ZONE("Renderer::drawTrail");
+    // Малюємо слід гравця: лише клітинки живих сегментів
+    for (int i = 0; i < trail.size(); i++) {
+        const Trail::Segment& segment = trail[i];
 
-    SDL_RenderPresent(renderer);
+        // Розраховуємо прозорість на основі часу існування сліду
+        float lifetime = (float)(currentTime - segment.timeCreated) / TRAIL_LIFETIME;
+        Uint8 alpha = static_cast<Uint8>(255 * (1.0f - std::min(lifetime, 1.0f)));
+
+        // Малюємо слід світло-жовтого кольору з прозорістю
+        SDL_Color trailColor = { startColor.r, startColor.g, startColor.b, alpha };
+
+        int stepX = (segment.toX > segment.fromX) - (segment.toX < segment.fromX);
+        int stepY = (segment.toY > segment.fromY) - (segment.toY < segment.fromY);
+        for (int x = segment.fromX, y = segment.fromY;; x += stepX, y += stepY) {
+            // Клітинку, яку пізніше перетнув новіший сегмент, малює він
+            if (trail.getVisitTime(x, y) == segment.timeCreated) {
+                SDL_FRect cellRect = { offsetX + x * cellSize, offsetY + y * cellSize, cellSize, cellSize };
+                cellBatch.addFill(trailColor, cellRect);
+            }
+            if (x == segment.toX && y == segment.toY) break;
+        }
+    }
+    cellBatch.flush(renderer);
 }
 
-void Renderer::drawLevelLose(const Level& level) {
-    // Аналогічно drawLevelWin, але з червоним кольором
+void Renderer::drawLevelEnd(const Level& level) {
+    TRACE_ZONE("Renderer::drawLevelEnd");
+    // Перемога заливає поле синім, поразка - червоним
+    bool won = level.isLevelFinished();
+    SDL_Color revealWallColor = won ? SDL_Color{ 0, 0, 150, 255 } : SDL_Color{ 150, 0, 0, 255 };
+    SDL_Color revealPathColor = won ? SDL_Color{ 100, 150, 255, 255 } : SDL_Color{ 255, 100, 100, 255 };
+
+    // Фон - такий же як для звичайного рівня
     SDL_SetRenderDrawColor(renderer, emptyColor.r, emptyColor.g, emptyColor.b, emptyColor.a);
     SDL_RenderClear(renderer);
+    drawCalls++;
 
     // Отримуємо розміри вікна
     int windowWidth, windowHeight;
     SDL_GetWindowSize(window, &windowWidth, &windowHeight);
 
-    // Малюємо рівень з анімацією "заливки" червоним кольором
-    for (int i = 0; i < level.getHeight(); i++) {
-        for (int j = 0; j < level.getWidth(); j++) {
-            SDL_FRect cellRect;
-            cellRect.x = offsetX + j * cellSize;
-            cellRect.y = offsetY + i * cellSize;
-            cellRect.w = cellSize;
-            cellRect.h = cellSize;
-
-            // Рахуємо відстань від клітинки до пастки (де стоїть гравець)
-            int distX = j - level.getPlayerX();
-            int distY = i - level.getPlayerY();
-            int distance = static_cast<int>(sqrt(distX * distX + distY * distY));
-
-            if (distance <= level.getAnimationRadius()) {
-                // Клітинки всередині радіусу анімації стають червоними
-                if (level.getTileAt(j, i) == WALL) {
-                    // Стіни - темно-червоні
-                    SDL_SetRenderDrawColor(renderer, 150, 0, 0, 255);
-                }
-                else {
-                    // Шлях - світло-червоний
-                    SDL_SetRenderDrawColor(renderer, 255, 100, 100, 255);
-                }
-            }
-            else {
-                // Інші клітинки звичайні
-                if (i == level.getPlayerY() && j == level.getPlayerX()) {
-                    // Гравець
-                    SDL_SetRenderDrawColor(renderer, playerColor.r, playerColor.g, playerColor.b, playerColor.a);
-                }
-                else {
-                    char tile = level.getTileAt(j, i);
-                    switch (tile) {
-                    case WALL:
-                        SDL_SetRenderDrawColor(renderer, wallColor.r, wallColor.g, wallColor.b, wallColor.a);
-                        break;
-                    case EMPTY:
-                        SDL_SetRenderDrawColor(renderer, emptyColor.r, emptyColor.g, emptyColor.b, emptyColor.a);
-                        break;
-                    case TRAP:
-                        SDL_SetRenderDrawColor(renderer, trapColor.r, trapColor.g, trapColor.b, trapColor.a);
-                        break;
-                    case FINISH:
-                        SDL_SetRenderDrawColor(renderer, finishColor.r, finishColor.g, finishColor.b, finishColor.a);
-                        break;
-                    case START:
-                        SDL_SetRenderDrawColor(renderer, startColor.r, startColor.g, startColor.b, startColor.a);
-                        break;
-                    default:
-                        SDL_SetRenderDrawColor(renderer, emptyColor.r, emptyColor.g, emptyColor.b, emptyColor.a);
-                    }
-                }
-            }
+    // Нова спроба (навіть якщо скасування і повторне завершення сталися в одному
+    // кадрі) має інший центр - стираємо кільця попередньої
+    if (level.getAttemptCount() != revealedAttempt) {
+        revealedAttempt = level.getAttemptCount();
+        boardDirty = true;
+    }
+    int visibleRings = min(level.getAnimationRadius() + 1, level.getRevealRingCount());
+    if ((boardDirty || !boardTexture) && !buildBoardLayer(level)) {
+        return;
+    }
 
-            SDL_RenderFillRect(renderer, &cellRect);
+    // Анімація "заливки": у текстуру поля домальовуємо лише кільця,
+    // що відкрились з минулого кадру (зазвичай одне на крок анімації)
+    if (revealedRings < visibleRings) {
+        const Grid& grid = level.getGrid();
+        for (int ring = revealedRings; ring < visibleRings; ring++) {
+            for (int cell : level.getRevealRing(ring)) {
+                SDL_FRect cellRect = { grid.indexX(cell) * cellSize, grid.indexY(cell) * cellSize, cellSize, cellSize };
+                cellBatch.addFill(grid[cell] == WALL ? revealWallColor : revealPathColor, cellRect);
+            }
         }
+
+        SDL_SetRenderTarget(renderer, boardTexture);
+        cellBatch.flush(renderer);
+        SDL_SetRenderTarget(renderer, NULL);
+        revealedRings = visibleRings;
     }
+    drawBoardLayer();
 
-    // Текст поразки
-    std::string loseText = "You Lose!";
-    renderText(loseText, (windowWidth - 200) / 2, offsetY - 40, trapColor, menuFont);
+    // Текст перемоги чи поразки
+    if (won) {
+        renderText("You Win!", (windowWidth - 200) / 2, offsetY - 40, finishColor, menuFont);
+    }
+    else {
+        renderText("You Lose!", (windowWidth - 200) / 2, offsetY - 40, trapColor, menuFont);
+    }
 
     // Інструкції
-    renderText("R - Restart   ESC - Menu   F - Fullscreen", 20, WINDOW_HEIGHT - 40, wallColor, smallFont);
+    renderText("R - Restart   Z - Undo   ESC - Menu   F - Fullscreen", 20, WINDOW_HEIGHT - 40, wallColor, smallFont);
+}
 
-    SDL_RenderPresent(renderer);
+void Renderer::drawBoardLayer() {
+    TRACE_ZONE("Renderer::drawBoardLayer");
+    float boardWidth, boardHeight;
+    SDL_GetTextureSize(boardTexture, &boardWidth, &boardHeight);
+    SDL_FRect boardRect = { offsetX, offsetY, boardWidth, boardHeight };
+    SDL_RenderTexture(renderer, boardTexture, NULL, &boardRect);
+    drawCalls++;
 }
 
 void Renderer::drawLevel(const Level& level) {
-    // Якщо рівень завершено або програно - відображаємо відповідний екран
-    if (level.isLevelFinished()) {
-        drawLevelWin(level);
+    TRACE_ZONE("Renderer::drawLevel");
+    // Якщо рівень завершено або програно - відображаємо анімацію завершення
+    if (level.isLevelFinished() || level.isLevelFailed()) {
+        drawLevelEnd(level);
         return;
     }
-    else if (level.isLevelFailed()) {
-        drawLevelLose(level);
-        return;
+
+    // Після анімації завершення (скасування ходу чи перезапуск) поле треба відновити
+    if (revealedRings > 0) {
+        boardDirty = true;
     }
 
     // Звичайне відображення рівня
     SDL_SetRenderDrawColor(renderer, emptyColor.r, emptyColor.g, emptyColor.b, emptyColor.a);
     SDL_RenderClear(renderer);
+    drawCalls++;
 
     // Отримуємо розміри вікна
     int windowWidth, windowHeight;
     SDL_GetWindowSize(window, &windowWidth, &windowHeight);
 
-    // Спочатку малюємо слід
+    // Незмінні клітинки - одним копіюванням готової текстури
+    if ((boardDirty || !boardTexture) && !buildBoardLayer(level)) {
+        return;
+    }
+    drawBoardLayer();
+
+    // Слід малюємо поверх клітинок, які він перекриває
     Uint32 currentTime = SDL_GetTicks();
     drawTrail(level.getTrail(), currentTime);
 
-    // Потім малюємо сам рівень
-    for (int i = 0; i < level.getHeight(); i++) {
-        for (int j = 0; j < level.getWidth(); j++) {
-            // Перевіряємо, чи є ця клітинка частиною сліду
-            bool isPartOfTrail = false;
-            for (const auto& point : level.getTrail()) {
-                if (point.x == j && point.y == i) {
-                    isPartOfTrail = true;
-                    break;
-                }
-            }
+    // Затемнюємо клітинки, з яких фініш уже недосяжний
+    if (showDoomedOverlay) {
+        SDL_BlendMode previousBlendMode;
+        SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+        SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+
+        for (int i = 0; i < level.getHeight(); i++) {
+            for (int j = 0; j < level.getWidth(); j++) {
+                if (level.getTileAt(j, i) == TRAP || !level.isCellDoomed(j, i)) continue;
 
-            // Якщо це не частина сліду, малюємо клітинку
-            if (!isPartOfTrail) {
-                SDL_FRect cellRect;
-                cellRect.x = offsetX + j * cellSize;
-                cellRect.y = offsetY + i * cellSize;
-                cellRect.w = cellSize;
-                cellRect.h = cellSize;
-
-                if (i == level.getPlayerY() && j == level.getPlayerX()) {
-                    // Гравець пріоритетніший від клітинки
-                    SDL_SetRenderDrawColor(renderer, playerColor.r, playerColor.g, playerColor.b, playerColor.a);
-                }
-                else {
-                    char tile = level.getTileAt(j, i);
-                    switch (tile) {
-                    case WALL:
-                        SDL_SetRenderDrawColor(renderer, wallColor.r, wallColor.g, wallColor.b, wallColor.a);
-                        break;
-                    case EMPTY:
-                        SDL_SetRenderDrawColor(renderer, emptyColor.r, emptyColor.g, emptyColor.b, emptyColor.a);
-                        break;
-                    case TRAP:
-                        SDL_SetRenderDrawColor(renderer, trapColor.r, trapColor.g, trapColor.b, trapColor.a);
-                        break;
-                    case FINISH:
-                        SDL_SetRenderDrawColor(renderer, finishColor.r, finishColor.g, finishColor.b, finishColor.a);
-                        break;
-                    case START:
-                        SDL_SetRenderDrawColor(renderer, startColor.r, startColor.g, startColor.b, startColor.a);
-                        break;
-                    default:
-                        SDL_SetRenderDrawColor(renderer, emptyColor.r, emptyColor.g, emptyColor.b, emptyColor.a);
-                    }
-                }
-
-                SDL_RenderFillRect(renderer, &cellRect);
+                SDL_FRect cellRect = { offsetX + j * cellSize, offsetY + i * cellSize, cellSize, cellSize };
+                cellBatch.addFill(doomedColor, cellRect);
             }
         }
+        cellBatch.flush(renderer);
+
+        SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
     }
 
     // Малюємо гравця зверху всього
@@ -675,14 +767,79 @@ void Renderer::drawLevel(const Level& level) {
 
     SDL_SetRenderDrawColor(renderer, playerColor.r, playerColor.g, playerColor.b, playerColor.a);
     SDL_RenderFillRect(renderer, &playerRect);
+    drawCalls++;
 
     // Інформація про рівень
     std::string levelName = "Level: ";
     levelName += std::to_string(level.getWidth()) + "x" + std::to_string(level.getHeight());
     renderText(levelName, 20, 20, wallColor, menuFont);
 
+    // Підказка: оптимальний наступний хід з поля відстаней до фінішу
+    if (showHint) {
+        const char* directionNames[DIR_COUNT] = { "Up", "Left", "Down", "Right" };
+        int hintDirection = level.getHintDirection();
+        std::string hintText = "Hint: no way to finish";
+
+        if (hintDirection >= 0) {
+            int target = level.getSlideTarget(level.getPlayerX(), level.getPlayerY(), hintDirection);
+            const Grid& grid = level.getGrid();
+            SDL_FRect targetRect = {
+                offsetX + grid.indexX(target) * cellSize,
+                offsetY + grid.indexY(target) * cellSize,
+                cellSize,
+                cellSize
+            };
+            SDL_SetRenderDrawColor(renderer, finishColor.r, finishColor.g, finishColor.b, finishColor.a);
+            SDL_RenderRect(renderer, &targetRect);
+            drawCalls++;
+
+            int movesLeft = level.getFinishDistance(level.getPlayerX(), level.getPlayerY());
+            hintText = std::string("Hint: ") + directionNames[hintDirection] + " (" + std::to_string(movesLeft) + " moves left)";
+        }
+
+        renderDynamicText(hintText, 20, 60, finishColor, smallFont);
+    }
+
     // Інструкції
-    renderText("R - Restart   ESC - Menu   F - Fullscreen", 20, WINDOW_HEIGHT - 40, wallColor, smallFont);
+    renderText("R - Restart   Z/Y - Undo/Redo   ESC - Menu   F - Fullscreen   O - Dead ends   H - Hint", 20, WINDOW_HEIGHT - 40, wallColor, smallFont);
+}
+
+void Renderer::drawProfilerOverlay(const FrameProfiler& profiler) {
+    TRACE_ZONE("Renderer::drawProfilerOverlay");
+    // Рядки змінюються при кожному оновленні - малюємо їх з атласу гліфів.
+    // Буфери на стеку: оверлей не повинен сам збільшувати лічильник виділень.
+    const int lineCount = FrameProfiler::PHASE_COUNT + 2;
+    char lines[lineCount][128];
+    SDL_snprintf(lines[0], sizeof(lines[0]), "Frame profiler (F3)     avg / p50 / p95 / max, ms");
+
+    for (int phase = 0; phase < FrameProfiler::PHASE_COUNT; phase++) {
+        FrameProfiler::PhaseStats stats = profiler.getPhaseStats((FrameProfiler::Phase)phase);
+        SDL_snprintf(lines[phase + 1], sizeof(lines[phase + 1]), "%-11s %6.2f %6.2f %6.2f %6.2f",
+            FrameProfiler::PHASE_NAMES[phase], stats.average, stats.median, stats.p95, stats.max);
+    }
 
+    const FrameProfiler::Frame& frame = profiler.getLastFrame();
+    SDL_snprintf(lines[lineCount - 1], sizeof(lines[lineCount - 1]), "draw calls %u   textures +%u/-%u   trail %u   allocs %u",
+        frame.drawCalls, frame.texturesCreated, frame.texturesDestroyed, frame.trailLength, frame.allocations);
+
+    const int lineHeight = 20;
+    SDL_FRect background = { 10.0f, 10.0f, 430.0f, (float)(lineCount * lineHeight + 10) };
+
+    SDL_BlendMode previousBlendMode;
+    SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+    SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 190);
+    SDL_RenderFillRect(renderer, &background);
+    drawCalls++;
+    SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
+
+    SDL_Color textColor = { 255, 255, 255, 255 };
+    for (int i = 0; i < lineCount; i++) {
+        renderDynamicText(lines[i], 18, 15 + i * lineHeight, textColor, smallFont);
+    }
+}
+
+void Renderer::present() {
+    TRACE_ZONE("Renderer::present");
     SDL_RenderPresent(renderer);
-}
\ No newline at end of file
+}
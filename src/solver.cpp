@@ -0,0 +1,68 @@
+#include "solver.h"
+#include "constants.h"
+#include <algorithm>
+
+SolveResult LevelSolver::solve(const Level& level) {
+    SolveResult result = { false, -1, 0, "" };
+
+    const Grid& grid = level.getGrid();
+    int startX = level.getPlayerX();
+    int startY = level.getPlayerY();
+    if (grid.isEmpty() || !grid.inBounds(startX, startY)) {
+        return result;
+    }
+
+    // Підготовка буферів (без виділення пам'яті, якщо рівень не більший за попередній)
+    int cellCount = grid.getCellCount();
+    distance.assign(cellCount, -1);
+    parent.resize(cellCount);
+    parentMove.resize(cellCount);
+    queue.resize(cellCount);
+
+    int start = grid.index(startX, startY);
+    int head = 0, tail = 0;
+    int finishCell = -1;
+
+    distance[start] = 0;
+    queue[tail++] = start;
+
+    while (head < tail) {
+        int cell = queue[head++];
+        int x = grid.indexX(cell);
+        int y = grid.indexY(cell);
+        result.reachableStops++;
+
+        for (int dir = 0; dir < DIR_COUNT; dir++) {
+            int target = level.getSlideTarget(x, y, dir);
+            if (target == cell || distance[target] >= 0) continue;
+
+            distance[target] = distance[cell] + 1;
+            parent[target] = cell;
+            parentMove[target] = DIRECTION_KEYS[dir];
+
+            char tile = grid[target];
+            if (tile == FINISH) {
+                // Перший знайдений фініш - найближчий; решту графа
+                // обходимо далі, щоб порахувати досяжні клітинки
+                if (finishCell < 0) finishCell = target;
+            }
+            else if (tile != TRAP) {
+                // Пастка - мертвий стан, з неї не розгортаємося
+                queue[tail++] = target;
+            }
+        }
+    }
+
+    if (finishCell < 0) {
+        return result;
+    }
+
+    result.solvable = true;
+    result.par = distance[finishCell];
+    result.moves.resize(result.par);
+    for (int cell = finishCell, i = result.par - 1; cell != start; cell = parent[cell], i--) {
+        result.moves[i] = parentMove[cell];
+    }
+
+    return result;
+}
@@ -0,0 +1,80 @@
+#include "textcache.h"
+#include "profiler.h"
+#include <functional>
+
+TextCache::TextCache(size_t memoryLimit)
+    : memoryLimit(memoryLimit), memoryUsed(0), hits(0), misses(0), evictions(0) {
+}
+
+TextCache::~TextCache() {
+    clear();
+}
+
+size_t TextCache::KeyHash::operator()(const KeyView& key) const {
+    size_t hash = std::hash<std::string_view>()(key.text);
+    hash ^= std::hash<const void*>()(key.font) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash ^= std::hash<Uint32>()(key.color) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+Uint32 TextCache::packColor(SDL_Color color) {
+    return ((Uint32)color.r << 24) | ((Uint32)color.g << 16) | ((Uint32)color.b << 8) | color.a;
+}
+
+SDL_Texture* TextCache::find(std::string_view text, TTF_Font* font, SDL_Color color) {
+    auto found = index.find(KeyView{ text, font, packColor(color) });
+    if (found == index.end()) {
+        misses++;
+        return nullptr;
+    }
+
+    hits++;
+    entries.splice(entries.begin(), entries, found->second);
+    return found->second->texture;
+}
+
+void TextCache::insert(std::string_view text, TTF_Font* font, SDL_Color color, SDL_Texture* texture) {
+    Key key = { std::string(text), font, packColor(color) };
+
+    auto found = index.find(key);
+    if (found != index.end()) {
+        memoryUsed -= found->second->size;
+        SDL_DestroyTexture(found->second->texture);
+        profiler::countTextureDestroyed();
+        entries.erase(found->second);
+        index.erase(found);
+    }
+
+    // Розмір оцінюємо як RGBA-пікселі текстури
+    float width = 0, height = 0;
+    SDL_GetTextureSize(texture, &width, &height);
+    size_t size = (size_t)width * (size_t)height * 4 + sizeof(Entry) + key.text.size();
+
+    entries.push_front({ key, texture, size });
+    index.emplace(std::move(key), entries.begin());
+    memoryUsed += size;
+    evictToLimit();
+}
+
+void TextCache::evictToLimit() {
+    // Найсвіжіший запис лишаємо навіть понад ліміт - його щойно малюють
+    while (memoryUsed > memoryLimit && entries.size() > 1) {
+        Entry& oldest = entries.back();
+        memoryUsed -= oldest.size;
+        SDL_DestroyTexture(oldest.texture);
+        profiler::countTextureDestroyed();
+        index.erase(oldest.key);
+        entries.pop_back();
+        evictions++;
+    }
+}
+
+void TextCache::clear() {
+    for (auto& entry : entries) {
+        SDL_DestroyTexture(entry.texture);
+        profiler::countTextureDestroyed();
+    }
+    entries.clear();
+    index.clear();
+    memoryUsed = 0;
+}
@@ -0,0 +1,482 @@
+#include "thumbnails.h"
+#include "constants.h"
+#include "grid.h"
+#include "level.h"
+#include "profiler.h"
+#include "trace.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+static const char THUMBNAIL_MAGIC[4] = { 'P', 'T', 'H', 'M' };
+static const Uint32 THUMBNAIL_CACHE_VERSION = 2;
+
+// FNV-1a по розмірах, старту і тайлах рівня
+static Uint64 hashLevel(int width, int height, int startX, int startY, std::span<const char> tiles) {
+    Uint64 hash = 14695981039346656037ULL;
+    auto mix = [&hash](const void* data, size_t size) {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash = (hash ^ bytes[i]) * 1099511628211ULL;
+        }
+    };
+    mix(&width, sizeof(width));
+    mix(&height, sizeof(height));
+    mix(&startX, sizeof(startX));
+    mix(&startY, sizeof(startY));
+    mix(tiles.data(), tiles.size());
+
+    return hash != 0 ? hash : 1; // 0 означає "мініатюри немає"
+}
+
+LevelThumbnails::LevelThumbnails() :
+    inFlight(0), running(false), pack(nullptr), palette{},
+    atlasSurface(nullptr), atlasTexture(nullptr),
+    useCounter(0), modified(false) {
+}
+
+LevelThumbnails::~LevelThumbnails() {
+    stop();
+}
+
+void LevelThumbnails::start(const LevelPack* pack, const Palette& palette, const std::string& cachePath) {
+    if (running) return;
+
+    this->pack = pack;
+    this->palette = palette;
+    this->cachePath = cachePath;
+
+    atlasSurface = SDL_CreateSurface(ATLAS_COLUMNS * THUMBNAIL_SIZE, ATLAS_ROWS * THUMBNAIL_SIZE, SDL_PIXELFORMAT_RGBA32);
+    if (!atlasSurface) {
+        cerr << "Failed to create thumbnail atlas: " << SDL_GetError() << endl;
+        return;
+    }
+    SDL_FillSurfaceRect(atlasSurface, NULL, 0);
+    loadCache();
+
+    running = true;
+    worker = std::thread(&LevelThumbnails::workerLoop, this);
+}
+
+void LevelThumbnails::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!running) return;
+        running = false;
+        pending.clear();
+    }
+    wake.notify_one();
+    worker.join();
+
+    for (auto& result : finished) {
+        SDL_DestroySurface(result.surface);
+    }
+    finished.clear();
+
+    if (modified) {
+        saveCache();
+    }
+    releaseTexture();
+    SDL_DestroySurface(atlasSurface);
+    atlasSurface = nullptr;
+    slots.clear();
+    slotByHash.clear();
+    levels.clear();
+}
+
+void LevelThumbnails::releaseTexture() {
+    if (atlasTexture) {
+        SDL_DestroyTexture(atlasTexture);
+        profiler::countTextureDestroyed();
+        atlasTexture = nullptr;
+    }
+}
+
+void LevelThumbnails::request(std::vector<Job> jobs) {
+    if (!running) return;
+
+    // Перевірені рівні з мініатюрою в атласі і непридатні рівні не чіпаємо;
+    // для решти передаємо відоме, щоб незмінений рівень не малювати заново
+    std::vector<Job> needed;
+    for (auto& job : jobs) {
+        if (failedNames.count(job.name)) continue;
+
+        auto found = levels.find(job.name);
+        if (found != levels.end()) {
+            const LevelInfo& info = found->second;
+            bool inAtlas = slotByHash.count(info.hash) > 0;
+            if (info.verified && inAtlas) continue;
+
+            job.knownHash = inAtlas ? info.hash : 0;
+            job.knownSize = info.fileSize;
+            job.knownModifyTime = info.modifyTime;
+        }
+        needed.push_back(std::move(job));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        pending.assign(std::make_move_iterator(needed.begin()), std::make_move_iterator(needed.end()));
+    }
+    wake.notify_one();
+}
+
+SDL_Rect LevelThumbnails::slotRect(int slot) const {
+    return { (slot % ATLAS_COLUMNS) * THUMBNAIL_SIZE, (slot / ATLAS_COLUMNS) * THUMBNAIL_SIZE, THUMBNAIL_SIZE, THUMBNAIL_SIZE };
+}
+
+int LevelThumbnails::allocateSlot(Uint64 hash) {
+    auto found = slotByHash.find(hash);
+    if (found != slotByHash.end()) {
+        return found->second;
+    }
+
+    int slot;
+    if ((int)slots.size() < ATLAS_COLUMNS * ATLAS_ROWS) {
+        slot = (int)slots.size();
+        slots.push_back({});
+    }
+    else {
+        // Атлас заповнений - витісняємо мініатюру, яку найдовше не показували
+        slot = (int)(std::min_element(slots.begin(), slots.end(), [](const Slot& a, const Slot& b) {
+            return a.lastUsed < b.lastUsed;
+        }) - slots.begin());
+        slotByHash.erase(slots[slot].hash);
+    }
+
+    slots[slot] = { hash, useCounter };
+    slotByHash[hash] = slot;
+    return slot;
+}
+
+bool LevelThumbnails::upload(SDL_Renderer* renderer) {
+    if (!running) return false;
+
+    std::vector<Result> ready;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        ready.swap(finished);
+    }
+
+    std::vector<Job> retries;
+    for (auto& result : ready) {
+        if (result.failed) {
+            failedNames.insert(result.job.name);
+            continue;
+        }
+
+        LevelInfo& info = levels[result.job.name];
+        if (info.hash != result.hash || info.fileSize != result.fileSize || info.modifyTime != result.modifyTime) {
+            modified = true;
+        }
+        info = { result.hash, result.fileSize, result.modifyTime, true };
+
+        auto found = slotByHash.find(result.hash);
+        if (found != slotByHash.end()) {
+            // Мініатюра з таким вмістом уже є (зокрема, під іншим іменем)
+            SDL_DestroySurface(result.surface);
+            continue;
+        }
+
+        if (!result.surface) {
+            // Слот витіснили, поки завдання було в роботі - без пікселів
+            // новий слот показав би мініатюру попереднього власника
+            Job retry = std::move(result.job);
+            retry.knownHash = 0;
+            retries.push_back(std::move(retry));
+            continue;
+        }
+
+        // Копіюємо без змішування, щоб прозорі краї затерли попередню мініатюру
+        int slot = allocateSlot(result.hash);
+        SDL_Rect rect = slotRect(slot);
+        SDL_SetSurfaceBlendMode(result.surface, SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(result.surface, NULL, atlasSurface, &rect);
+        SDL_DestroySurface(result.surface);
+        if (std::find(dirtySlots.begin(), dirtySlots.end(), slot) == dirtySlots.end()) {
+            dirtySlots.push_back(slot);
+        }
+        modified = true;
+    }
+
+    if (!retries.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            pending.insert(pending.begin(), std::make_move_iterator(retries.begin()), std::make_move_iterator(retries.end()));
+        }
+        wake.notify_one();
+    }
+
+    if (!atlasTexture) {
+        atlasTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC,
+            atlasSurface->w, atlasSurface->h);
+        if (!atlasTexture) {
+            cerr << "Failed to create thumbnail texture: " << SDL_GetError() << endl;
+            return false;
+        }
+        profiler::countTextureCreated();
+        SDL_SetTextureBlendMode(atlasTexture, SDL_BLENDMODE_BLEND);
+
+        // Нова текстура отримує весь атлас одним вивантаженням
+        SDL_UpdateTexture(atlasTexture, NULL, atlasSurface->pixels, atlasSurface->pitch);
+        dirtySlots.clear();
+        return true;
+    }
+
+    // Змінені слоти вивантажуємо порціями, щоб не навантажувати один кадр
+    int uploads = std::min((int)dirtySlots.size(), UPLOADS_PER_FRAME);
+    for (int i = 0; i < uploads; i++) {
+        SDL_Rect rect = slotRect(dirtySlots[i]);
+        const Uint8* pixels = static_cast<const Uint8*>(atlasSurface->pixels) + rect.y * atlasSurface->pitch + rect.x * 4;
+        SDL_UpdateTexture(atlasTexture, &rect, pixels, atlasSurface->pitch);
+    }
+    dirtySlots.erase(dirtySlots.begin(), dirtySlots.begin() + uploads);
+    return uploads > 0;
+}
+
+bool LevelThumbnails::isBusy() {
+    if (!running) return false;
+    if (!dirtySlots.empty()) return true;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return !pending.empty() || !finished.empty() || inFlight > 0;
+}
+
+bool LevelThumbnails::find(const std::string& name, SDL_FRect& sourceRect) {
+    auto level = levels.find(name);
+    if (level == levels.end() || !atlasTexture) return false;
+    auto found = slotByHash.find(level->second.hash);
+    if (found == slotByHash.end()) return false;
+
+    int slot = found->second;
+    if (std::find(dirtySlots.begin(), dirtySlots.end(), slot) != dirtySlots.end()) {
+        return false; // Ще не вивантажено на відеокарту
+    }
+
+    slots[slot].lastUsed = ++useCounter;
+    SDL_Rect rect = slotRect(slot);
+    SDL_RectToFRect(&rect, &sourceRect);
+    return true;
+}
+
+void LevelThumbnails::workerLoop() {
+    TRACE_THREAD_NAME("thumbnails");
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this]() { return !running || !pending.empty(); });
+            if (!running) return;
+
+            job = std::move(pending.front());
+            pending.pop_front();
+            inFlight++;
+        }
+
+        // Читання і малювання поза блокуванням
+        TRACE_ZONE("LevelThumbnails::render");
+        Result result = { std::move(job), 0, 0, 0, nullptr, false };
+        result.failed = !renderJob(result.job, result);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        finished.push_back(std::move(result));
+        inFlight--;
+    }
+}
+
+bool LevelThumbnails::renderJob(const Job& job, Result& result) const {
+    Grid grid;
+    int startX = 0, startY = 0;
+    std::span<const char> tiles;
+    int width, height;
+
+    if (job.packIndex >= 0) {
+        const LevelPack::IndexEntry& entry = pack->getEntry(job.packIndex);
+        width = entry.width;
+        height = entry.height;
+        startX = entry.startX;
+        startY = entry.startY;
+        tiles = pack->getTiles(job.packIndex);
+    }
+    else {
+        SDL_PathInfo info;
+        if (!SDL_GetPathInfo(job.filePath.c_str(), &info) || info.type != SDL_PATHTYPE_FILE) {
+            return false;
+        }
+        result.fileSize = info.size;
+        result.modifyTime = info.modify_time;
+
+        // Файл не змінився з минулої перевірки - не читаємо і не хешуємо його
+        if (job.knownHash != 0 && info.size == job.knownSize && info.modify_time == job.knownModifyTime) {
+            result.hash = job.knownHash;
+            return true;
+        }
+
+        if (!Level::readLevelFile(job.filePath, grid, startX, startY)) {
+            return false;
+        }
+        width = grid.getWidth();
+        height = grid.getHeight();
+        tiles = grid.data();
+    }
+
+    result.hash = hashLevel(width, height, startX, startY, tiles);
+    if (result.hash == job.knownHash) {
+        return true; // Збережена мініатюра актуальна
+    }
+
+    SDL_Surface* surface = SDL_CreateSurface(THUMBNAIL_SIZE, THUMBNAIL_SIZE, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        return false;
+    }
+    SDL_FillSurfaceRect(surface, NULL, 0);
+
+    // Вписуємо рівень у квадрат зі збереженням пропорцій, по клітинці на кожен піксель
+    float scale = std::min((float)THUMBNAIL_SIZE / width, (float)THUMBNAIL_SIZE / height);
+    int drawWidth = std::max(1, (int)(width * scale));
+    int drawHeight = std::max(1, (int)(height * scale));
+    int offsetX = (THUMBNAIL_SIZE - drawWidth) / 2;
+    int offsetY = (THUMBNAIL_SIZE - drawHeight) / 2;
+
+    for (int py = 0; py < drawHeight; py++) {
+        int cellY = std::min(height - 1, (int)(py / scale));
+        Uint8* row = static_cast<Uint8*>(surface->pixels) + (offsetY + py) * surface->pitch;
+
+        for (int px = 0; px < drawWidth; px++) {
+            int cellX = std::min(width - 1, (int)(px / scale));
+            char cell = tiles[cellY * width + cellX];
+
+            SDL_Color color;
+            if (cellX == startX && cellY == startY) {
+                color = palette.start;
+            }
+            else {
+                switch (cell) {
+                case WALL: color = palette.wall; break;
+                case TRAP: color = palette.trap; break;
+                case FINISH: color = palette.finish; break;
+                case START: color = palette.start; break;
+                default: color = palette.empty; break;
+                }
+            }
+
+            Uint8* pixel = row + (offsetX + px) * 4;
+            pixel[0] = color.r;
+            pixel[1] = color.g;
+            pixel[2] = color.b;
+            pixel[3] = color.a;
+        }
+    }
+
+    result.surface = surface;
+    return true;
+}
+
+bool LevelThumbnails::loadCache() {
+    std::ifstream inFile(cachePath, std::ios::binary);
+    if (!inFile) {
+        return false;
+    }
+
+    char magic[4];
+    Uint32 version = 0, size = 0, levelCount = 0, slotCount = 0;
+    inFile.read(magic, sizeof(magic));
+    inFile.read(reinterpret_cast<char*>(&version), sizeof(version));
+    inFile.read(reinterpret_cast<char*>(&size), sizeof(size));
+    inFile.read(reinterpret_cast<char*>(&levelCount), sizeof(levelCount));
+    inFile.read(reinterpret_cast<char*>(&slotCount), sizeof(slotCount));
+
+    if (!inFile || std::memcmp(magic, THUMBNAIL_MAGIC, sizeof(magic)) != 0 ||
+        version != THUMBNAIL_CACHE_VERSION || size != THUMBNAIL_SIZE) {
+        cerr << "Ignoring outdated thumbnail cache: " << cachePath << endl;
+        return false;
+    }
+
+    // Імена рівнів і хеші їхнього вмісту (ще не перевірені в цьому сеансі)
+    for (Uint32 i = 0; i < levelCount; i++) {
+        LevelInfo info = { 0, 0, 0, false };
+        Uint16 nameLength = 0;
+        inFile.read(reinterpret_cast<char*>(&info.hash), sizeof(info.hash));
+        inFile.read(reinterpret_cast<char*>(&info.fileSize), sizeof(info.fileSize));
+        inFile.read(reinterpret_cast<char*>(&info.modifyTime), sizeof(info.modifyTime));
+        inFile.read(reinterpret_cast<char*>(&nameLength), sizeof(nameLength));
+        std::string name(nameLength, '\0');
+        inFile.read(name.data(), nameLength);
+        if (!inFile) {
+            levels.clear();
+            return false;
+        }
+        levels[std::move(name)] = info;
+    }
+
+    // Мініатюри за хешем вмісту
+    slotCount = std::min(slotCount, (Uint32)(ATLAS_COLUMNS * ATLAS_ROWS));
+    for (Uint32 i = 0; i < slotCount; i++) {
+        Uint64 hash = 0;
+        inFile.read(reinterpret_cast<char*>(&hash), sizeof(hash));
+        if (!inFile || hash == 0) break;
+
+        // Рядки мініатюри читаємо прямо в її місце в атласі
+        int slot = allocateSlot(hash);
+        SDL_Rect rect = slotRect(slot);
+        for (int y = 0; y < THUMBNAIL_SIZE; y++) {
+            char* row = static_cast<char*>(atlasSurface->pixels) + (rect.y + y) * atlasSurface->pitch + rect.x * 4;
+            inFile.read(row, THUMBNAIL_SIZE * 4);
+        }
+        if (!inFile) {
+            // Обрізаний файл - мініатюру буде перемальовано
+            slotByHash.erase(hash);
+            slots[slot].hash = 0;
+            break;
+        }
+    }
+
+    return true;
+}
+
+void LevelThumbnails::saveCache() const {
+    std::ofstream outFile(cachePath, std::ios::binary | std::ios::trunc);
+    if (!outFile) {
+        cerr << "Failed to save thumbnail cache: " << cachePath << endl;
+        return;
+    }
+
+    // Зберігаємо лише імена, мініатюра яких є в атласі
+    Uint32 levelCount = 0;
+    for (const auto& [name, info] : levels) {
+        if (slotByHash.count(info.hash)) levelCount++;
+    }
+    Uint32 slotCount = (Uint32)slotByHash.size();
+
+    Uint32 size = THUMBNAIL_SIZE;
+    outFile.write(THUMBNAIL_MAGIC, sizeof(THUMBNAIL_MAGIC));
+    outFile.write(reinterpret_cast<const char*>(&THUMBNAIL_CACHE_VERSION), sizeof(THUMBNAIL_CACHE_VERSION));
+    outFile.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    outFile.write(reinterpret_cast<const char*>(&levelCount), sizeof(levelCount));
+    outFile.write(reinterpret_cast<const char*>(&slotCount), sizeof(slotCount));
+
+    for (const auto& [name, info] : levels) {
+        if (!slotByHash.count(info.hash)) continue;
+
+        Uint16 nameLength = (Uint16)name.size();
+        outFile.write(reinterpret_cast<const char*>(&info.hash), sizeof(info.hash));
+        outFile.write(reinterpret_cast<const char*>(&info.fileSize), sizeof(info.fileSize));
+        outFile.write(reinterpret_cast<const char*>(&info.modifyTime), sizeof(info.modifyTime));
+        outFile.write(reinterpret_cast<const char*>(&nameLength), sizeof(nameLength));
+        outFile.write(name.data(), nameLength);
+    }
+
+    for (const auto& [hash, slot] : slotByHash) {
+        outFile.write(reinterpret_cast<const char*>(&hash), sizeof(hash));
+
+        SDL_Rect rect = slotRect(slot);
+        for (int y = 0; y < THUMBNAIL_SIZE; y++) {
+            const char* row = static_cast<const char*>(atlasSurface->pixels) + (rect.y + y) * atlasSurface->pitch + rect.x * 4;
+            outFile.write(row, THUMBNAIL_SIZE * 4);
+        }
+    }
+}
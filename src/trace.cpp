@@ -0,0 +1,139 @@
+#include "trace.h"
+
+#ifdef PUSHPUSH_TRACE
+
+#include "constants.h"
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    struct Event {
+        const char* name;
+        Uint64 start;
+        Uint64 end;
+    };
+
+    // Кільце останніх подій потоку. Пише лише власний потік, тож запис без
+    // блокувань; лічильник атомарний, щоб збереження бачило записані події.
+    struct ThreadBuffer {
+        std::unique_ptr<Event[]> events;
+        std::atomic<Uint64> written{ 0 };
+        std::atomic<const char*> name{ nullptr };
+        int threadId = 0;
+    };
+
+    // Блокування лише при першій зоні нового потоку. Буфери не звільняються:
+    // потік може завершитись раніше, ніж зони буде збережено.
+    std::mutex registryMutex;
+    std::vector<ThreadBuffer*>& getRegistry() {
+        static std::vector<ThreadBuffer*>* registry = new std::vector<ThreadBuffer*>();
+        return *registry;
+    }
+
+    ThreadBuffer* getThreadBuffer() {
+        thread_local ThreadBuffer* buffer = nullptr;
+        if (!buffer) {
+            ThreadBuffer* created = new ThreadBuffer();
+            created->events = std::make_unique<Event[]>(TRACE_BUFFER_EVENTS);
+
+            std::lock_guard<std::mutex> lock(registryMutex);
+            created->threadId = (int)getRegistry().size() + 1;
+            getRegistry().push_back(created);
+            buffer = created;
+        }
+        return buffer;
+    }
+
+    void writeString(std::ostream& out, const char* text) {
+        out << '"';
+        for (; *text; text++) {
+            if (*text == '"' || *text == '\\') out << '\\';
+            out << *text;
+        }
+        out << '"';
+    }
+}
+
+void tracing::record(const char* name, Uint64 start, Uint64 end) {
+    ThreadBuffer* buffer = getThreadBuffer();
+    Uint64 index = buffer->written.load(std::memory_order_relaxed);
+    buffer->events[index % TRACE_BUFFER_EVENTS] = { name, start, end };
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+void tracing::setThreadName(const char* name) {
+    getThreadBuffer()->name.store(name, std::memory_order_relaxed);
+}
+
+bool tracing::save(const std::string& path) {
+    std::vector<ThreadBuffer*> threads;
+    {
+        std::lock_guard<std::mutex> lock(registryMutex);
+        threads = getRegistry();
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        cerr << "Failed to write trace: " << path << endl;
+        return false;
+    }
+
+    // Час у мікросекундах, як очікує формат
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+
+    bool first = true;
+    Uint64 savedEvents = 0;
+    Uint64 droppedEvents = 0;
+    for (ThreadBuffer* thread : threads) {
+        const char* threadName = thread->name.load(std::memory_order_relaxed);
+        if (threadName) {
+            file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":"
+                << thread->threadId << ",\"args\":{\"name\":";
+            writeString(file, threadName);
+            file << "}}";
+            first = false;
+        }
+
+        // У кільці лишились лише останні події потоку
+        Uint64 written = thread->written.load(std::memory_order_acquire);
+        Uint64 kept = std::min<Uint64>(written, TRACE_BUFFER_EVENTS);
+        droppedEvents += written - kept;
+
+        std::vector<Event> events;
+        events.reserve((size_t)kept);
+        for (Uint64 i = written - kept; i < written; i++) {
+            events.push_back(thread->events[i % TRACE_BUFFER_EVENTS]);
+        }
+
+        // Зовнішня зона закінчується пізніше за вкладені - впорядковуємо за початком
+        std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+            return a.start != b.start ? a.start < b.start : a.end > b.end;
+        });
+
+        for (const Event& event : events) {
+            file << (first ? "" : ",\n") << "{\"name\":";
+            writeString(file, event.name);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread->threadId
+                << ",\"ts\":" << event.start / 1000.0 << ",\"dur\":" << (event.end - event.start) / 1000.0 << "}";
+            first = false;
+        }
+        savedEvents += kept;
+    }
+
+    file << "\n]}\n";
+
+    cout << "Trace saved: " << savedEvents << " zones from " << threads.size() << " threads ("
+        << droppedEvents << " older zones overwritten) to " << path << endl;
+    return (bool)file;
+}
+
+#endif
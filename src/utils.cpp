@@ -1,5 +1,6 @@
 #include "utils.h"
 #include <filesystem>
+#include <cctype>
 
 namespace fs = std::filesystem;
 using namespace std;
@@ -27,4 +28,48 @@ namespace utils {
             return false;
         }
     }
+    // Природне порівняння імен: числа порівнюються за значенням ("level2" < "level10")
+    bool naturalLess(const std::string& a, const std::string& b) {
+        size_t i = 0, j = 0;
+        while (i < a.size() && j < b.size()) {
+            bool digitA = std::isdigit(static_cast<unsigned char>(a[i])) != 0;
+            bool digitB = std::isdigit(static_cast<unsigned char>(b[j])) != 0;
+
+            if (digitA && digitB) {
+                // Пропускаємо провідні нулі і порівнюємо числа за довжиною, потім за цифрами
+                size_t startA = i, startB = j;
+                while (startA < a.size() && a[startA] == '0') startA++;
+                while (startB < b.size() && b[startB] == '0') startB++;
+                size_t endA = startA, endB = startB;
+                while (endA < a.size() && std::isdigit(static_cast<unsigned char>(a[endA]))) endA++;
+                while (endB < b.size() && std::isdigit(static_cast<unsigned char>(b[endB]))) endB++;
+
+                if (endA - startA != endB - startB) {
+                    return endA - startA < endB - startB;
+                }
+                int digits = a.compare(startA, endA - startA, b, startB, endB - startB);
+                if (digits != 0) {
+                    return digits < 0;
+                }
+
+                i = endA;
+                j = endB;
+                continue;
+            }
+
+            char lowerA = (char)std::tolower(static_cast<unsigned char>(a[i]));
+            char lowerB = (char)std::tolower(static_cast<unsigned char>(b[j]));
+            if (lowerA != lowerB) {
+                return lowerA < lowerB;
+            }
+            i++;
+            j++;
+        }
+
+        if (a.size() - i != b.size() - j) {
+            return a.size() - i < b.size() - j;
+        }
+        // Рівні за природним порядком імена впорядковуємо звичайним порівнянням
+        return a < b;
+    }
 }
\ No newline at end of file